@@ -18,6 +18,7 @@ CPPFLAGS += \
 
 CPPFLAGS += \
             -DCONFIG_ENABLE_FCS32 \
+            -DCONFIG_ENABLE_FCS32C \
             -DCONFIG_ENABLE_FCS16 \
             -DCONFIG_ENABLE_CHECKSUM \
             -DCONFIG_ENABLE_STATS
@@ -0,0 +1,119 @@
+/*
+    Copyright 2022 (C) Alexey Dynda
+
+    This file is part of Tiny Protocol Library.
+
+    Protocol Library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Protocol Library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Protocol Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * Compares throughput of tiny_crc16() / tiny_crc32() / tiny_crc32c() with plain byte-by-byte
+ * table loops for different block sizes.
+ *   tiny_crc_benchmark [total_megabytes]
+ */
+
+#include "proto/crc/tiny_crc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+static volatile uint32_t s_sink;
+
+#ifdef CONFIG_ENABLE_FCS16
+static uint32_t fcs16_bytewise(const uint8_t *p, int len)
+{
+    uint16_t crc = PPPINITFCS16;
+    while ( len-- )
+        crc = crc16_byte(crc, *p++);
+    return crc;
+}
+
+static uint32_t fcs16_fast(const uint8_t *p, int len)
+{
+    return tiny_crc16(PPPINITFCS16, p, len);
+}
+#endif
+
+#ifdef CONFIG_ENABLE_FCS32
+static uint32_t fcs32_bytewise(const uint8_t *p, int len)
+{
+    uint32_t crc = PPPINITFCS32;
+    while ( len-- )
+        crc = crc32_byte(crc, *p++);
+    return crc;
+}
+
+static uint32_t fcs32_fast(const uint8_t *p, int len)
+{
+    return tiny_crc32(PPPINITFCS32, p, len);
+}
+#endif
+
+#ifdef CONFIG_ENABLE_FCS32C
+static uint32_t crc32c_bytewise(const uint8_t *p, int len)
+{
+    uint32_t crc = PPPINITFCS32C;
+    while ( len-- )
+        crc = crc32c_byte(crc, *p++);
+    return crc;
+}
+
+static uint32_t crc32c_fast(const uint8_t *p, int len)
+{
+    return tiny_crc32c(PPPINITFCS32C, p, len);
+}
+#endif
+
+static void measure(uint32_t (*func)(const uint8_t *, int), const std::vector<uint8_t> &data, int block, size_t total)
+{
+    size_t iterations = total / block;
+    auto start = std::chrono::steady_clock::now();
+    for ( size_t i = 0; i < iterations; i++ )
+    {
+        s_sink = s_sink + func(data.data() + (i * block) % (data.size() - block), block);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printf(" %9.1f MB/s", (double)(iterations * block) / elapsed.count() / 1000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t total = (argc > 1 ? strtoul(argv[1], nullptr, 10) : 256) * 1000000;
+    std::vector<uint8_t> data(1 << 20);
+    for ( auto &b : data )
+        b = (uint8_t)rand();
+    static const int blocks[] = {16, 64, 256, 1500, 4096};
+    printf("%8s %14s %14s %14s %14s %14s %14s\n", "block", "fcs16 byte", "fcs16 fast", "fcs32 byte", "fcs32 fast",
+           "crc32c byte", "crc32c fast");
+    for ( int block : blocks )
+    {
+        printf("%8d", block);
+#ifdef CONFIG_ENABLE_FCS16
+        measure(fcs16_bytewise, data, block, total);
+        measure(fcs16_fast, data, block, total);
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        measure(fcs32_bytewise, data, block, total);
+        measure(fcs32_fast, data, block, total);
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        measure(crc32c_bytewise, data, block, total);
+        measure(crc32c_fast, data, block, total);
+#endif
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+    Copyright 2022 (C) Alexey Dynda
+
+    This file is part of Tiny Protocol Library.
+
+    Protocol Library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Protocol Library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Protocol Library.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/**
+ * Compares throughput of default and table driven hdlc_ll decoders on clean stream,
+ * stream with many escaped bytes and noisy stream (garbage and corrupted frames), for
+ * different sizes of chunks passed to hdlc_ll_run_rx().
+ *   tiny_hdlc_benchmark [total_megabytes]
+ */
+
+#include "proto/hdlc/low_level/hdlc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+static int s_frames;
+
+static int on_frame_read(void *user_data, void *data, int len)
+{
+    (void)user_data;
+    (void)data;
+    (void)len;
+    s_frames++;
+    return 0;
+}
+
+/* special_rate: percent of 0x7E/0x7D bytes in payload, noise: add garbage and corrupted frames */
+static std::vector<uint8_t> generate_stream(int special_rate, bool noise)
+{
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> frame(256);
+    std::vector<uint8_t> encoded(HDLC_LL_ENCODED_MAX_SIZE(256, HDLC_CRC_16));
+    srand(1);
+    while ( stream.size() < (1 << 20) )
+    {
+        for ( auto &b : frame )
+            b = rand() % 100 < special_rate ? (rand() % 2 ? 0x7E : 0x7D) : (uint8_t)rand();
+        int len = hdlc_ll_encode_frame(encoded.data(), (int)encoded.size(), frame.data(), (int)frame.size(),
+                                       HDLC_CRC_16);
+        if ( noise && rand() % 4 == 0 )
+            encoded[1 + rand() % (len - 2)] ^= 0x01;
+        stream.insert(stream.end(), encoded.begin(), encoded.begin() + len);
+        for ( int n = noise ? rand() % 64 : 0; n > 0; n-- )
+            stream.push_back((uint8_t)rand());
+    }
+    return stream;
+}
+
+static void measure(bool table_decoder, const std::vector<uint8_t> &stream, int chunk, size_t total)
+{
+    std::vector<uint8_t> buffer(hdlc_ll_get_buf_size_ex(512, HDLC_CRC_16));
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer.data();
+    init.buf_size = (int)buffer.size();
+    init.crc_type = HDLC_CRC_16;
+    init.on_frame_read = on_frame_read;
+    init.table_decoder = table_decoder;
+    hdlc_ll_init(&handle, &init);
+    size_t processed = 0;
+    auto start = std::chrono::steady_clock::now();
+    while ( processed < total )
+    {
+        for ( size_t pos = 0; pos + chunk <= stream.size(); pos += chunk )
+        {
+            int done = 0;
+            while ( done < chunk )
+                done += hdlc_ll_run_rx(handle, stream.data() + pos + done, chunk - done, nullptr);
+        }
+        processed += stream.size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    hdlc_ll_close(handle);
+    printf(" %9.1f MB/s", (double)processed / elapsed.count() / 1000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t total = (argc > 1 ? strtoul(argv[1], nullptr, 10) : 256) * 1000000;
+    static const struct
+    {
+        const char *name;
+        int special_rate;
+        bool noise;
+    } profiles[] = {
+        {"clean", 0, false},
+        {"escapes", 30, false},
+        {"noisy", 1, true},
+    };
+    static const int chunks[] = {64, 4096};
+    printf("%8s %6s %14s %14s\n", "stream", "chunk", "default", "table");
+    for ( auto &profile : profiles )
+    {
+        std::vector<uint8_t> stream = generate_stream(profile.special_rate, profile.noise);
+        for ( int chunk : chunks )
+        {
+            printf("%8s %6d", profile.name, chunk);
+            measure(false, stream, chunk, total);
+            measure(true, stream, chunk, total);
+            printf("\n");
+        }
+    }
+    return s_frames ? 0 : 1;
+}
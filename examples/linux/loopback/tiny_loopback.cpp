@@ -32,6 +32,7 @@ enum class protocol_type_t : uint8_t
 };
 
 static hdlc_crc_t s_crc = HDLC_CRC_8;
+static hdlc_framing_t s_framing = HDLC_FRAMING_HDLC;
 static char *s_port = nullptr;
 static bool s_generatorEnabled = false;
 static bool s_loopbackMode = true;
@@ -55,7 +56,8 @@ static void print_help()
     fprintf(stderr, "    -t <proto>, --protocol <proto> type of protocol to use\n");
     fprintf(stderr, "                               fd - full duplex (default)\n");
     fprintf(stderr, "                               light - full duplex\n");
-    fprintf(stderr, "    -c <crc>, --crc <crc>      crc type: 0, 8, 16, 32\n");
+    fprintf(stderr, "    -c <crc>, --crc <crc>      crc type: 0, 8, 16, 32, 33 (crc32c)\n");
+    fprintf(stderr, "    -f <type>, --framing <type> framing: hdlc (default), cobs, length (reliable streams only)\n");
     fprintf(stderr, "    -g, --generator            turn on packet generating\n");
     fprintf(stderr, "    -s, --size                 packet size: 64 (by default)\n");
     fprintf(stderr, "    -w, --window               window size: 7 (by default)\n");
@@ -93,9 +95,26 @@ static int parse_args(int argc, char *argv[])
                 case 8: s_crc = HDLC_CRC_8; break;
                 case 16: s_crc = HDLC_CRC_16; break;
                 case 32: s_crc = HDLC_CRC_32; break;
+                case 33: s_crc = HDLC_CRC_32C; break;
                 default: fprintf(stderr, "CRC type not supported\n"); return -1;
             }
         }
+        else if ( (!strcmp(argv[i], "-f")) || (!strcmp(argv[i], "--framing")) )
+        {
+            if ( ++i >= argc )
+                return -1;
+            if ( !strcmp(argv[i], "hdlc") )
+                s_framing = HDLC_FRAMING_HDLC;
+            else if ( !strcmp(argv[i], "cobs") )
+                s_framing = HDLC_FRAMING_COBS;
+            else if ( !strcmp(argv[i], "length") )
+                s_framing = HDLC_FRAMING_LENGTH;
+            else
+            {
+                fprintf(stderr, "Framing type not supported\n");
+                return -1;
+            }
+        }
         else if ( (!strcmp(argv[i], "-s")) || (!strcmp(argv[i], "--size")) )
         {
             if ( ++i >= argc )
@@ -184,6 +203,7 @@ static int run_fd(tiny_serial_handle_t port)
     s_serialFd = port;
     tinyproto::FdD proto(tiny_fd_buffer_size_by_mtu(s_packetSize, s_windowSize));
     proto.enableCrc(s_crc);
+    proto.setFraming(s_framing);
     // Set window size to 4 frames. This should be the same value, used by other size
     proto.setWindowSize(s_windowSize);
     // Set send timeout to 1000ms as we are going to use multithread mode
@@ -257,6 +277,7 @@ static int run_light(tiny_serial_handle_t port)
     s_serialFd = port;
     tinyproto::Light proto;
     proto.enableCrc(s_crc);
+    proto.setFraming(s_framing);
 
     proto.begin([](void *a, const void *b, int c) -> int { return tiny_serial_send(s_serialFd, b, c); },
                 [](void *a, void *b, int c) -> int { return tiny_serial_read(s_serialFd, b, c); });
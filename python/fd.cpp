@@ -96,18 +96,22 @@ static PyObject *Fd_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 
 ////////////////////////////// Internal callbacks
 
-static void on_frame_read(void *user_data, uint8_t *data, int len)
+static void on_frame_read_batch(void *user_data, const tiny_fd_rx_frame_t *frames, int count)
 {
     Fd *self = (Fd *)user_data;
     if ( self->on_frame_read )
     {
+        // Acquire GIL once for all frames, received in single rx() call
         PyGILState_STATE gstate;
         gstate = PyGILState_Ensure();
 
-        PyObject *arg = PyByteArray_FromStringAndSize((const char *)data, (Py_ssize_t)len);
-        PyObject *temp = PyObject_CallFunctionObjArgs(self->on_frame_read, arg, NULL);
-        Py_XDECREF(temp); // Dereference result
-        Py_DECREF(arg);   // We do not need ByteArray anymore
+        for ( int i = 0; i < count; i++ )
+        {
+            PyObject *arg = PyByteArray_FromStringAndSize((const char *)frames[i].data, (Py_ssize_t)frames[i].len);
+            PyObject *temp = PyObject_CallFunctionObjArgs(self->on_frame_read, arg, NULL);
+            Py_XDECREF(temp); // Dereference result
+            Py_DECREF(arg);   // We do not need ByteArray anymore
+        }
 
         PyGILState_Release(gstate);
     }
@@ -157,11 +161,13 @@ static PyObject *Fd_begin(Fd *self)
 {
     tiny_fd_init_t init{};
     init.pdata = self;
-    init.on_frame_cb = on_frame_read;
+    init.on_read_batch_cb = on_frame_read_batch;
+    init.zero_copy_rx = true;
     init.on_sent_cb = on_frame_sent;
     init.on_connect_event_cb = on_connect_event;
     init.crc_type = self->crc_type;
-    init.buffer_size = tiny_fd_buffer_size_by_mtu_ex(1, self->mtu, self->window_size, init.crc_type);
+    init.buffer_size = tiny_fd_buffer_size_by_mtu_ex(1, self->mtu, self->window_size, init.crc_type) +
+                       CONFIG_TINY_FD_RX_BATCH_SIZE * sizeof(tiny_fd_rx_frame_t) + TINY_ALIGN_STRUCT_VALUE;
     self->buffer = PyObject_Malloc(init.buffer_size);
     init.buffer = self->buffer;
     init.send_timeout = 1000;
@@ -438,6 +444,7 @@ static int Fd_set_crc(Fd *self, PyObject *value)
     {
         int temp = PyLong_AsLong(value);
         if ( temp == HDLC_CRC_16 || temp == HDLC_CRC_32 ||
+             temp == HDLC_CRC_32C ||
              temp == HDLC_CRC_8 || temp == HDLC_CRC_OFF ||
              temp == HDLC_CRC_DEFAULT )
         {
@@ -447,7 +454,7 @@ static int Fd_set_crc(Fd *self, PyObject *value)
     }
     if ( result < 0 )
     {
-        PyErr_Format(PyExc_RuntimeError, "Allowable CRC values are: 0 (AUTO), 8, 16, 32, 255 (OFF)");
+        PyErr_Format(PyExc_RuntimeError, "Allowable CRC values are: 0 (AUTO), 8, 16, 32, 33 (CRC-32C), 255 (OFF)");
     }
     return result/* 0 on success, -1 on failure with error set. */;
 }
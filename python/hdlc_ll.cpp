@@ -228,6 +228,45 @@ static PyObject *Hdlc_tx(Hdlc *self, PyObject *args)
     }
 }
 
+static PyObject *Hdlc_encode(Hdlc *self, PyObject *args)
+{
+    Py_buffer buffer{};
+    if ( !PyArg_ParseTuple(args, "s*", &buffer) )
+    {
+        return NULL;
+    }
+    int size = HDLC_LL_ENCODED_MAX_SIZE((int)buffer.len, self->crc_type);
+    void *data = PyObject_Malloc(size);
+    int result = hdlc_ll_encode_frame(data, size, buffer.buf, (int)buffer.len, self->crc_type);
+    PyBuffer_Release(&buffer);
+    PyObject *frame = NULL;
+    if ( result < 0 )
+    {
+        PyErr_Format(PyExc_RuntimeError, "Failed to encode frame: %d", result);
+    }
+    else
+    {
+        frame = PyByteArray_FromStringAndSize((const char *)data, result);
+    }
+    PyObject_Free(data);
+    return frame;
+}
+
+static PyObject *Hdlc_decode(Hdlc *self, PyObject *args)
+{
+    Py_buffer buffer{};
+    if ( !PyArg_ParseTuple(args, "s*", &buffer) )
+    {
+        return NULL;
+    }
+    int size = self->mtu + get_crc_field_size(self->crc_type);
+    void *data = PyObject_Malloc(size);
+    int result = hdlc_ll_decode_buffer(buffer.buf, (int)buffer.len, data, size, self->crc_type, on_frame_read, self);
+    PyObject_Free(data);
+    PyBuffer_Release(&buffer);
+    return PyLong_FromLong((long)result);
+}
+
 ///////////////////////////////// GETTERS SETTERS
 
 static PyObject *Hdlc_get_on_read(Hdlc *self, void *closure)
@@ -272,6 +311,7 @@ static int Hdlc_set_crc(Hdlc *self, PyObject *value)
     {
         int temp = PyLong_AsLong(value);
         if ( temp == HDLC_CRC_16 || temp == HDLC_CRC_32 ||
+             temp == HDLC_CRC_32C ||
              temp == HDLC_CRC_8 || temp == HDLC_CRC_OFF ||
              temp == HDLC_CRC_DEFAULT )
         {
@@ -281,7 +321,7 @@ static int Hdlc_set_crc(Hdlc *self, PyObject *value)
     }
     if ( result < 0 )
     {
-        PyErr_Format(PyExc_RuntimeError, "Allowable CRC values are: 0 (AUTO), 8, 16, 32, 255 (OFF)");
+        PyErr_Format(PyExc_RuntimeError, "Allowable CRC values are: 0 (AUTO), 8, 16, 32, 33 (CRC-32C), 255 (OFF)");
     }
     return result/* 0 on success, -1 on failure with error set. */;
 }
@@ -301,6 +341,9 @@ static PyMethodDef Hdlc_methods[] = {
     {"put", (PyCFunction)Hdlc_put, METH_VARARGS, "Puts new message for sending"},
     {"rx", (PyCFunction)Hdlc_rx, METH_VARARGS, "Passes rx data"},
     {"tx", (PyCFunction)Hdlc_tx, METH_VARARGS, "Fills specified buffer with tx data"},
+    {"encode", (PyCFunction)Hdlc_encode, METH_VARARGS, "Encodes the whole frame at once and returns it"},
+    {"decode", (PyCFunction)Hdlc_decode, METH_VARARGS,
+     "Decodes all complete frames in the data via on_read callback, returns number of processed bytes"},
     {NULL} /* Sentinel */
 };
 
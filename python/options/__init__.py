@@ -30,5 +30,6 @@ HDLC_CRC_DEFAULT = 0
 HDLC_CRC_8       = 8
 HDLC_CRC_16      = 16
 HDLC_CRC_32      = 32
+HDLC_CRC_32C     = 33
 HDLC_CRC_OFF     = 0xFF
 
@@ -0,0 +1,230 @@
+/*
+    Copyright 2022 (C) Alexey Dynda
+
+    This file is part of Tiny Protocol Library.
+
+    GNU General Public License Usage
+
+    Protocol Library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Protocol Library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Protocol Library.  If not, see <http://www.gnu.org/licenses/>.
+
+    Commercial License Usage
+
+    Licensees holding valid commercial Tiny Protocol licenses may use this file in
+    accordance with the commercial license agreement provided in accordance with
+    the terms contained in a written agreement between you and Alexey Dynda.
+    For further information contact via email on github account.
+*/
+
+/**
+ This is Tiny protocol implementation for microcontrollers
+
+ @file
+ @brief Tiny protocol compile-time CRC templates
+
+*/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace tinyproto
+{
+
+/// \cond
+namespace details
+{
+template <unsigned... I> struct CrcIndexes
+{
+};
+
+template <unsigned N, unsigned... I> struct MakeCrcIndexes: MakeCrcIndexes<N - 1, N - 1, I...>
+{
+};
+
+template <unsigned... I> struct MakeCrcIndexes<0, I...>
+{
+    typedef CrcIndexes<I...> type;
+};
+} // namespace details
+/// \endcond
+
+/**
+ * Table driven CRC calculator. Lookup table is generated at compile time, and all
+ * methods are inline, so the compiler can optimize the loop for the specific polynomial.
+ * Unlike tiny_crc16() / tiny_crc32(), crc type is resolved at compile time.
+ * The class can also be used in constant expressions to check constant frames:
+ *
+ * @code{.cpp}
+ * static_assert(tinyproto::Fcs16::calc("123456789", 9) == 0x906E, "FCS16 check failed");
+ * @endcode
+ *
+ * @tparam T unsigned type to hold crc register, defines crc width (uint16_t or uint32_t)
+ * @tparam Poly generator polynomial in normal (not reflected) form, for example 0x1021 for CCITT-16
+ * @tparam Init initial value of crc register
+ * @tparam Reflect true if the bits of input bytes and crc are reflected (LSB first like in RFC 1662)
+ * @tparam XorOut value to xor crc register with at the end of calculation
+ * @note The table takes 256 * sizeof(T) bytes, and is placed to RAM on AVR.
+ */
+template <typename T, T Poly, T Init, bool Reflect = true, T XorOut = Init> class Crc
+{
+public:
+    /// Crc register width in bits
+    static constexpr unsigned width = sizeof(T) * 8;
+
+    /**
+     * Returns initial value of crc register
+     */
+    static constexpr T init()
+    {
+        return Init;
+    }
+
+    /**
+     * Updates crc register with single byte
+     * @param crc current value of crc register
+     * @param byte byte to process
+     */
+    static constexpr T update(T crc, uint8_t byte)
+    {
+        return Reflect ? static_cast<T>(table.data[(crc ^ byte) & 0xFF] ^ (crc >> 8))
+                       : static_cast<T>(table.data[((crc >> (width - 8)) ^ byte) & 0xFF] ^ (crc << 8));
+    }
+
+    /**
+     * Updates crc register with the block of data. Final xor is not applied.
+     * @param crc current value of crc register
+     * @param data pointer to the data
+     * @param len length of the data in bytes
+     */
+    static inline T update(T crc, const void *data, int len)
+    {
+        const uint8_t *p = static_cast<const uint8_t *>(data);
+        while ( len >= 4 )
+        {
+            crc = update(crc, p[0]);
+            crc = update(crc, p[1]);
+            crc = update(crc, p[2]);
+            crc = update(crc, p[3]);
+            p += 4;
+            len -= 4;
+        }
+        while ( len-- > 0 )
+        {
+            crc = update(crc, *p++);
+        }
+        return crc;
+    }
+
+    /**
+     * Applies final xor to crc register
+     */
+    static constexpr T finalize(T crc)
+    {
+        return static_cast<T>(crc ^ XorOut);
+    }
+
+    /**
+     * Calculates crc of the block of data
+     * @param data pointer to the data
+     * @param len length of the data in bytes
+     */
+    static inline T compute(const void *data, int len)
+    {
+        return finalize(update(Init, data, len));
+    }
+
+    /**
+     * Calculates crc of the constant string at compile time
+     * @param str constant string
+     * @param len length of the string
+     */
+    static constexpr T calc(const char *str, size_t len)
+    {
+        return finalize(updateConst(Init, str, len));
+    }
+
+    /**
+     * Returns value of crc register (without final xor) after processing valid frame
+     * together with its crc field sent LSB first. Applicable to reflected crc only.
+     */
+    static constexpr T residue()
+    {
+        return residueStep(Init, finalize(Init), sizeof(T));
+    }
+
+private:
+    /// \cond
+    struct Table
+    {
+        T data[256];
+    };
+
+    static constexpr T reflectBits(T value, unsigned bits)
+    {
+        return bits == 0 ? 0 : static_cast<T>(((value & 1) << (bits - 1)) | reflectBits(value >> 1, bits - 1));
+    }
+
+    static constexpr T poly()
+    {
+        return Reflect ? reflectBits(Poly, width) : Poly;
+    }
+
+    static constexpr T shift(T crc, unsigned bits)
+    {
+        return bits == 0 ? crc
+                         : shift(Reflect ? static_cast<T>((crc & 1) ? ((crc >> 1) ^ poly()) : (crc >> 1))
+                                         : static_cast<T>((crc >> (width - 1)) ? ((crc << 1) ^ Poly) : (crc << 1)),
+                                 bits - 1);
+    }
+
+    static constexpr T entry(unsigned index)
+    {
+        return shift(Reflect ? static_cast<T>(index) : static_cast<T>(static_cast<T>(index) << (width - 8)), 8);
+    }
+
+    template <unsigned... I> static constexpr Table makeTable(details::CrcIndexes<I...>)
+    {
+        return Table{{entry(I)...}};
+    }
+
+    static constexpr T updateConst(T crc, const char *str, size_t len)
+    {
+        return len == 0 ? crc : updateConst(update(crc, static_cast<uint8_t>(*str)), str + 1, len - 1);
+    }
+
+    static constexpr T residueStep(T crc, T fcs, unsigned bytes)
+    {
+        return bytes == 0 ? crc : residueStep(update(crc, static_cast<uint8_t>(fcs)), fcs >> 8, bytes - 1);
+    }
+
+    static constexpr Table table = makeTable(typename details::MakeCrcIndexes<256>::type());
+    /// \endcond
+};
+
+/// \cond
+template <typename T, T Poly, T Init, bool Reflect, T XorOut>
+constexpr typename Crc<T, Poly, Init, Reflect, XorOut>::Table Crc<T, Poly, Init, Reflect, XorOut>::table;
+/// \endcond
+
+/** FCS-16 (CCITT-16) as defined in RFC 1662, same as tiny_crc16() */
+typedef Crc<uint16_t, 0x1021, 0xFFFF> Fcs16;
+
+/** FCS-32 (CCITT-32) as defined in RFC 1662, same as tiny_crc32() */
+typedef Crc<uint32_t, 0x04C11DB7, 0xFFFFFFFF> Fcs32;
+
+/** CRC-32C (Castagnoli), same as tiny_crc32c() */
+typedef Crc<uint32_t, 0x1EDC6F41, 0xFFFFFFFF> Crc32c;
+
+} // namespace tinyproto
@@ -44,6 +44,7 @@ namespace tinyproto
 void Light::begin(write_block_cb_t writecb, read_block_cb_t readcb)
 {
     m_data.crc_type = m_crc;
+    m_data.framing = m_framing;
     tiny_light_init(&m_data, writecb, readcb, this);
 }
 
@@ -115,6 +116,21 @@ bool Light::enableCrc32()
 #endif
 }
 
+bool Light::enableCrc32c()
+{
+#if defined(CONFIG_ENABLE_FCS32C)
+    m_crc = HDLC_CRC_32C;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Light::setFraming(hdlc_framing_t framing)
+{
+    m_framing = framing;
+}
+
 #ifdef ARDUINO
 
 static int writeToSerial(void *p, const void *b, int s)
@@ -212,12 +212,32 @@ public:
      */
     bool enableCrc32();
 
+    /**
+     * Enables CRC-32C (Castagnoli) 32-bit field in the protocol.
+     * Both sides of the link must use the same CRC type. On x86-64
+     * CPUs with SSE4.2 the checksum is calculated in hardware.
+     * @return true if successful
+     *         false in case of error.
+     */
+    bool enableCrc32c();
+
+    /**
+     * Sets framing to use on the link. By default standard HDLC framing is used.
+     * HDLC_FRAMING_COBS adds at most 1 byte per 254 bytes of the frame, regardless
+     * of the data being sent. HDLC_FRAMING_LENGTH is for reliable streams only.
+     * Must be called before begin().
+     * @param framing framing type
+     */
+    void setFraming(hdlc_framing_t framing);
+
     void user_data(void * data) { this->m_data.user_data = data; };
 
 private:
     STinyLightData m_data{};
 
     hdlc_crc_t m_crc = HDLC_CRC_DEFAULT;
+
+    hdlc_framing_t m_framing = HDLC_FRAMING_HDLC;
 };
 
 /**
@@ -37,6 +37,7 @@
 #pragma once
 
 #include "TinyPacket.h"
+#include "TinyCrc.h"
 #include "TinyLightProtocol.h"
 #include "TinyProtocolHdlc.h"
 #include "TinyProtocolFd.h"
@@ -70,6 +70,7 @@ void IFd::begin()
     init.retry_timeout = 200;
     init.retries = 2;
     init.crc_type = m_crc;
+    init.framing = m_framing;
     init.mode = TINY_FD_MODE_ABM;
 
     tiny_fd_init(&m_handle, &init);
@@ -92,6 +93,17 @@ int IFd::write(const IPacket &pkt)
     return tiny_fd_send_packet(m_handle, pkt.m_buf, pkt.m_len);
 }
 
+IPacket IFd::reserve(int size, uint32_t timeout)
+{
+    void *buf = tiny_fd_reserve_packet(m_handle, TINY_FD_PRIMARY_ADDR, size, timeout);
+    return IPacket((char *)buf, buf ? size : 0);
+}
+
+int IFd::commit(const IPacket &pkt)
+{
+    return tiny_fd_commit_packet(m_handle, pkt.m_buf, pkt.m_len);
+}
+
 int IFd::run_rx(const void *data, int len)
 {
     return tiny_fd_on_rx_data(m_handle, data, len);
@@ -163,6 +175,17 @@ bool IFd::enableCrc32()
     return true;
 }
 
+bool IFd::enableCrc32c()
+{
+    m_crc = HDLC_CRC_32C;
+    return true;
+}
+
+void IFd::setFraming(hdlc_framing_t framing)
+{
+    m_framing = framing;
+}
+
 ///////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////
 
@@ -111,6 +111,23 @@ public:
      */
     int write(const IPacket &pkt);
 
+    /**
+     * Reserves space for next message in the protocol queue, so the message can be
+     * serialized directly to the protocol memory. Fill the packet, and pass it to commit().
+     * @param size - maximum size of the message in bytes
+     * @param timeout - maximum time in milliseconds to wait for free space
+     * @return empty packet, which buffer points to the protocol queue, or packet
+     *         with zero size if there is no free space.
+     */
+    IPacket reserve(int size, uint32_t timeout);
+
+    /**
+     * Sends packet, obtained via reserve().
+     * @param pkt - Packet to send. Empty packet cancels the reservation.
+     * @return TINY_SUCCESS or TINY_ERR_INVALID_DATA if the packet is not reserved one.
+     */
+    int commit(const IPacket &pkt);
+
     /**
      * Processes incoming rx data, specified by a user.
      * @param data pointer to the buffer with incoming data
@@ -187,6 +204,26 @@ public:
      */
     bool enableCrc32();
 
+    /**
+     * Enables CRC-32C (Castagnoli) 32-bit field in the protocol.
+     * Both sides of the link must use the same CRC type. On x86-64
+     * CPUs with SSE4.2 the checksum is calculated in hardware.
+     * @return true if successful
+     *         false in case of error.
+     */
+    bool enableCrc32c();
+
+    /**
+     * Sets framing to use on the link. By default standard HDLC framing is used.
+     * HDLC_FRAMING_COBS adds at most 1 byte per 254 bytes of the frame, regardless
+     * of the data being sent. HDLC_FRAMING_LENGTH just copies the frames with length prefix,
+     * and should be used over reliable streams only (TCP, unix sockets), usually with crc disabled.
+     * Both sides of the link must use the same framing.
+     * Must be called before begin().
+     * @param framing framing type
+     */
+    void setFraming(hdlc_framing_t framing);
+
     /**
      * Sets receive callback for incoming messages
      * @param on_receive user callback to process incoming messages. The processing must be non-blocking
@@ -217,7 +254,8 @@ public:
     /**
      * Sets desired window size. Use this function only before begin() call.
      * window size is number of frames, which confirmation may be deferred for.
-     * @param window window size, valid between 1 - 7 inclusively
+     * @param window window size, valid between 1 - 127 inclusively. Values above 7 require extended
+     *        HDLC format, supported by remote side.
      * @warning if you use smallest window size, this can reduce throughput of the channel.
      */
     void setWindowSize(uint8_t window)
@@ -311,6 +349,8 @@ private:
 
     hdlc_crc_t m_crc = HDLC_CRC_DEFAULT;
 
+    hdlc_framing_t m_framing = HDLC_FRAMING_HDLC;
+
     /** max buffer size */
     int m_bufferSize = 0;
 
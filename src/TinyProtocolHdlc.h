@@ -176,6 +176,15 @@ public:
      */
     bool enableCrc32();
 
+    /**
+     * Enables CRC-32C (Castagnoli) 32-bit field in the protocol.
+     * Both sides of the link must use the same CRC type. On x86-64
+     * CPUs with SSE4.2 the checksum is calculated in hardware.
+     * @return true if successful
+     *         false in case of error.
+     */
+    bool enableCrc32c();
+
     /**
      * Sets receive callback for incoming messages
      * @param on_receive user callback to process incoming messages. The processing must be non-blocking
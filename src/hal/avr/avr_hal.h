@@ -47,6 +47,15 @@
 //#   define CONFIG_ENABLE_FCS32
 //#endif
 
+//#ifndef CONFIG_ENABLE_FCS32C
+//#   define CONFIG_ENABLE_FCS32C
+//#endif
+
+/* Keep hdlc TX queue small to save RAM */
+#ifndef CONFIG_HDLC_LL_TX_QUEUE_SIZE
+#define CONFIG_HDLC_LL_TX_QUEUE_SIZE 1
+#endif
+
 /**
  * Mutex type used by Tiny Protocol implementation.
  * The type declaration depends on platform.
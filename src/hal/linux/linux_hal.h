@@ -45,6 +45,14 @@
 #define CONFIG_ENABLE_FCS32
 #endif
 
+#ifndef CONFIG_ENABLE_FCS32C
+#define CONFIG_ENABLE_FCS32C
+#endif
+
+#ifndef CONFIG_ENABLE_FAST_CRC
+#define CONFIG_ENABLE_FAST_CRC
+#endif
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 /**
@@ -40,6 +40,8 @@ extern "C"
 #define INITCHECKSUM 0x0000
 #define GOODCHECKSUM 0x0000
     uint16_t chksum_byte(uint16_t sum, uint8_t data);
+    /** Adds bytes to the running sum. Unlike tiny_chksum(), the sum is not inverted */
+    uint16_t chksum_update(uint16_t sum, const uint8_t *data, int data_length);
     uint16_t tiny_chksum(uint16_t sum, const uint8_t* data, int data_length);
 #endif
 
@@ -47,18 +49,47 @@ extern "C"
 #define PPPINITFCS16 0xffff /* Initial FCS value */
 #define PPPGOODFCS16 0xf0b8 /* Good final FCS value */
     uint16_t crc16_byte(uint16_t crc, uint8_t data);
+    /**
+     * Updates running FCS16 register with the block of data. Unlike tiny_crc16() the final xor
+     * is not applied, so the result can be passed to the next call. Processing a frame together
+     * with its FCS field gives PPPGOODFCS16 for a valid frame.
+     */
+    uint16_t crc16_update(uint16_t crc, const uint8_t *data, int data_length);
     uint16_t tiny_crc16(uint16_t crc, const uint8_t* data, int data_length);
+    /**
+     * Calculates FCS16 of two adjacent blocks A and B, without reading the data.
+     * @param crc1 tiny_crc16() result for block A
+     * @param crc2 tiny_crc16() result for block B
+     * @param len2 length of block B in bytes
+     * @return tiny_crc16() result for A followed by B
+     */
+    uint16_t crc16_combine(uint16_t crc1, uint16_t crc2, int len2);
 #endif
 
 #ifdef CONFIG_ENABLE_FCS32
 #define PPPINITFCS32 0xffffffff /* Initial FCS value */
 #define PPPGOODFCS32 0xdebb20e3 /* Good final FCS value */
     uint32_t crc32_byte(uint32_t crc, uint8_t data);
+    /** Updates running FCS32 register without final xor, see crc16_update() */
+    uint32_t crc32_update(uint32_t crc, const uint8_t *buf, int size);
     uint32_t tiny_crc32(uint32_t crc, const uint8_t *buf, int size);
+    /** Calculates FCS32 of two adjacent blocks from their tiny_crc32() results, see crc16_combine() */
+    uint32_t crc32_combine(uint32_t crc1, uint32_t crc2, int len2);
+#endif
+
+#ifdef CONFIG_ENABLE_FCS32C
+#define PPPINITFCS32C 0xffffffff /* Initial CRC-32C value */
+#define PPPGOODFCS32C 0xb798b438 /* Good final CRC-32C value */
+    uint32_t crc32c_byte(uint32_t crc, uint8_t data);
+    /** Updates running CRC-32C register without final xor, see crc16_update() */
+    uint32_t crc32c_update(uint32_t crc, const uint8_t *buf, int size);
+    uint32_t tiny_crc32c(uint32_t crc, const uint8_t *buf, int size);
+    /** Calculates CRC-32C of two adjacent blocks from their tiny_crc32c() results, see crc16_combine() */
+    uint32_t crc32c_combine(uint32_t crc1, uint32_t crc2, int len2);
 #endif
 
 /// \cond
-#ifdef CONFIG_ENABLE_FCS32
+#if defined(CONFIG_ENABLE_FCS32) || defined(CONFIG_ENABLE_FCS32C)
     typedef uint32_t crc_t;
 #else
 typedef uint16_t crc_t;
@@ -74,6 +105,7 @@ typedef uint16_t crc_t;
         HDLC_CRC_8 = 8,       ///< Simple sum of all bytes in user payload
         HDLC_CRC_16 = 16,     ///< CCITT-16
         HDLC_CRC_32 = 32,     ///< CCITT-32
+        HDLC_CRC_32C = 33,    ///< CRC-32C (Castagnoli), 32-bit field. Value / 8 must give field size in bytes
         HDLC_CRC_OFF = 0xFF,  ///< Disable CRC field
     } hdlc_crc_t;
 
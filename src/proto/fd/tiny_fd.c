@@ -31,6 +31,7 @@
 #include "hal/tiny_types.h"
 #include "hal/tiny_debug.h"
 
+#include <stddef.h>
 #include <string.h>
 
 #ifndef TINY_FD_DEBUG
@@ -49,6 +50,7 @@
 #define HDLC_S_FRAME_BITS 0x01
 #define HDLC_S_FRAME_MASK 0x03
 #define HDLC_S_FRAME_TYPE_REJ 0x04
+#define HDLC_S_FRAME_TYPE_SREJ 0x0C
 #define HDLC_S_FRAME_TYPE_RR 0x00
 #define HDLC_S_FRAME_TYPE_MASK 0x0C
 
@@ -60,11 +62,15 @@
 #define HDLC_U_FRAME_TYPE_RSET 0x8C
 #define HDLC_U_FRAME_TYPE_SABM 0x2C
 #define HDLC_U_FRAME_TYPE_SNRM 0x80
+#define HDLC_U_FRAME_TYPE_SABME 0x6C
+#define HDLC_U_FRAME_TYPE_SNRME 0xCC
 #define HDLC_U_FRAME_TYPE_DISC 0x40
 #define HDLC_U_FRAME_TYPE_MASK 0xEC
 
 #define HDLC_P_BIT 0x10
 #define HDLC_F_BIT 0x10
+// P/F bit of I- and S-frames is located in the 2nd byte of extended control field
+#define HDLC_EXT_P_BIT 0x01
 
 #define HDLC_CR_BIT 0x02
 #define HDLC_E_BIT 0x01
@@ -77,10 +83,11 @@ enum
     FD_EVENT_QUEUE_HAS_FREE_SLOTS = 0x04,  // Global event
     FD_EVENT_CAN_ACCEPT_I_FRAMES = 0x08,   // Local event
     FD_EVENT_HAS_MARKER          = 0x10,   // Global event
+    FD_EVENT_TX_PIPE_HAS_DATA    = 0x20,   // Global event
+    FD_EVENT_TX_PIPE_HAS_ROOM    = 0x40,   // Global event
+    FD_EVENT_RX_POOL_HAS_ROOM    = 0x80,   // Global event
 };
 
-static const uint8_t seq_bits_mask = 0x07;
-
 static int on_frame_read(void *user_data, void *data, int len);
 static int on_frame_sent(void *user_data, const void *data, int len);
 
@@ -168,10 +175,67 @@ static uint8_t __switch_to_next_peer(tiny_fd_handle_t handle)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static inline uint8_t __seq_bits_mask(tiny_fd_handle_t handle, uint8_t peer)
+{
+    return handle->peers[peer].extended ? 0x7F : 0x07;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t __ext_control_size(tiny_fd_handle_t handle, uint8_t peer, const uint8_t *data)
+{
+    // U-frames always have 1-byte control field
+    return (handle->peers[peer].extended && (data[1] & HDLC_U_FRAME_MASK) != HDLC_U_FRAME_BITS) ? TINY_FD_EXT_CONTROL_SIZE : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static inline int __header_size(tiny_fd_handle_t handle, uint8_t peer, const uint8_t *data)
+{
+    return sizeof(tiny_frame_header_t) + __ext_control_size(handle, peer, data);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t __get_nr(tiny_fd_handle_t handle, uint8_t peer, const uint8_t *data)
+{
+    return __ext_control_size(handle, peer, data) ? (data[2] >> 1) : (data[1] >> 5);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t __get_ns(tiny_fd_handle_t handle, uint8_t peer, const uint8_t *data)
+{
+    return (data[1] >> 1) & __seq_bits_mask(handle, peer);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t __get_pf_bit(tiny_fd_handle_t handle, uint8_t peer, const uint8_t *data)
+{
+    return __ext_control_size(handle, peer, data) ? (data[2] & HDLC_EXT_P_BIT) : (data[1] & HDLC_P_BIT);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static inline void __set_poll_bit(tiny_fd_handle_t handle, uint8_t peer, uint8_t *data)
+{
+    if ( __ext_control_size(handle, peer, data) )
+    {
+        data[2] |= HDLC_EXT_P_BIT;
+    }
+    else
+    {
+        data[1] |= HDLC_P_BIT;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 #if 0
 static inline uint8_t __number_of_awaiting_tx_i_frames(tiny_fd_handle_t handle, uint8_t peer)
 {
-    return ((uint8_t)(handle->peers[peer].last_ns - handle->peers[peer].confirm_ns) & seq_bits_mask);
+    return ((uint8_t)(handle->peers[peer].last_ns - handle->peers[peer].confirm_ns) & __seq_bits_mask(handle, peer));
 }
 #endif
 
@@ -233,26 +297,108 @@ static tiny_fd_frame_info_t *__put_u_s_frame_to_tx_queue(tiny_fd_handle_t handle
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static tiny_fd_frame_info_t *__put_s_frame_to_tx_queue(tiny_fd_handle_t handle, uint8_t peer, uint8_t address, uint8_t type)
+{
+    const uint8_t nr = handle->peers[peer].next_nr;
+    const bool ext = handle->peers[peer].extended;
+    uint8_t frame[sizeof(tiny_frame_header_t) + TINY_FD_EXT_CONTROL_SIZE] = {
+        address,
+        (uint8_t)(HDLC_S_FRAME_BITS | type | (ext ? 0 : (nr << 5))),
+        (uint8_t)(nr << 1),
+    };
+    return __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, frame,
+                                       ext ? (int)sizeof(frame) : (int)sizeof(tiny_frame_header_t));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static tiny_fd_frame_info_t *__put_set_mode_frame_to_tx_queue(tiny_fd_handle_t handle, uint8_t peer, uint8_t address, int type)
+{
+    // Extended format is requested only if the window doesn't fit modulo 8 sequence numbers
+    const bool ext = handle->frames.i_queue.size > 7;
+    tiny_frame_header_t frame = {
+        .address = address,
+        .control = HDLC_U_FRAME_BITS,
+    };
+    if ( handle->mode == TINY_FD_MODE_NRM )
+    {
+        frame.control |= ext ? HDLC_U_FRAME_TYPE_SNRME : HDLC_U_FRAME_TYPE_SNRM;
+    }
+    else
+    {
+        frame.control |= ext ? HDLC_U_FRAME_TYPE_SABME : HDLC_U_FRAME_TYPE_SABM;
+    }
+    handle->peers[peer].extended = ext;
+    return __put_u_s_frame_to_tx_queue(handle, type, &frame, sizeof(tiny_frame_header_t));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static bool __can_accept_i_frames(tiny_fd_handle_t handle, uint8_t peer)
 {
-    uint8_t next_last_ns = (handle->peers[peer].last_ns + 1) & seq_bits_mask;
+    // Reserved slots will get their sequence numbers on commit, so they occupy the window already
+    uint8_t next_last_ns = (handle->peers[peer].last_ns + handle->peers[peer].reserved + 1) & __seq_bits_mask(handle, peer);
     bool can_accept = next_last_ns != handle->peers[peer].confirm_ns;
     return can_accept;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static void __commit_i_frame(tiny_fd_handle_t handle, uint8_t peer, tiny_fd_frame_info_t *slot)
+{
+    const uint8_t ext_control = handle->peers[peer].extended ? TINY_FD_EXT_CONTROL_SIZE : 0;
+    if ( slot->ext_control != ext_control )
+    {
+        // The link was re-established with different control field format, since the slot was reserved
+        memmove(&slot->payload[ext_control], &slot->payload[slot->ext_control], slot->len);
+        slot->ext_control = ext_control;
+    }
+    if ( handle->cache_crc )
+    {
+        slot->crc = hdlc_ll_crc(handle->_hdlc->crc_type, &slot->payload[ext_control], slot->len);
+    }
+    slot->type = TINY_FD_QUEUE_I_FRAME;
+    slot->header.address = __peer_to_address_field( handle, peer );
+    // N(R) is filled in every time the frame is sent
+    slot->header.control = handle->peers[peer].last_ns << 1;
+    LOG(TINY_LOG_DEB, "[%p] QUEUE I-PUT: [%02X] [%02X]\n", handle, slot->header.address, slot->header.control);
+    handle->peers[peer].last_ns = (handle->peers[peer].last_ns + 1) & __seq_bits_mask(handle, peer);
+    tiny_events_set(&handle->events, FD_EVENT_TX_DATA_AVAILABLE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static bool __put_i_frame_to_tx_queue(tiny_fd_handle_t handle, uint8_t peer, const void *data, int len)
 {
-    tiny_fd_frame_info_t *slot = tiny_fd_queue_allocate( &handle->frames.i_queue, TINY_FD_QUEUE_I_FRAME, data, len );
+    const bool ext = handle->peers[peer].extended;
+    // User data follows 2nd byte of control field for extended format
+    tiny_fd_frame_info_t *slot = tiny_fd_queue_allocate( &handle->frames.i_queue, TINY_FD_QUEUE_I_FRAME, ext ? NULL : data, len );
     // Check if space is actually available
     if ( slot != NULL )
     {
-        LOG(TINY_LOG_DEB, "[%p] QUEUE I-PUT: [%02X] [%02X]\n", handle, slot->header.address, slot->header.control);
+        if ( ext )
+        {
+            slot->ext_control = TINY_FD_EXT_CONTROL_SIZE;
+            memcpy(&slot->payload[TINY_FD_EXT_CONTROL_SIZE], data, len);
+        }
+        __commit_i_frame(handle, peer, slot);
+        return true;
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool __reserve_i_frame(tiny_fd_handle_t handle, uint8_t peer, int len, uint8_t **payload)
+{
+    tiny_fd_frame_info_t *slot = tiny_fd_queue_allocate( &handle->frames.i_queue, TINY_FD_QUEUE_RESERVED, NULL, len );
+    if ( slot != NULL )
+    {
+        // Address is needed to find the peer on commit
         slot->header.address = __peer_to_address_field( handle, peer );
-        slot->header.control = handle->peers[peer].last_ns << 1;
-        handle->peers[peer].last_ns = (handle->peers[peer].last_ns + 1) & seq_bits_mask;
-        tiny_events_set(&handle->events, FD_EVENT_TX_DATA_AVAILABLE);
+        slot->ext_control = handle->peers[peer].extended ? TINY_FD_EXT_CONTROL_SIZE : 0;
+        handle->peers[peer].reserved++;
+        *payload = &slot->payload[slot->ext_control];
         return true;
     }
     return false;
@@ -260,28 +406,158 @@ static bool __put_i_frame_to_tx_queue(tiny_fd_handle_t handle, uint8_t peer, con
 
 ///////////////////////////////////////////////////////////////////////////////
 
-static int __check_received_frame(tiny_fd_handle_t handle, uint8_t peer, uint8_t ns)
+static uint8_t *__rx_pool_frame(tiny_fd_handle_t handle, uint8_t index, int *size)
+{
+    if ( index == 0 )
+    {
+        *size = handle->rx_pool.hdlc_buf_size;
+        return (uint8_t *)handle->rx_pool.hdlc_buf;
+    }
+    *size = handle->rx_pool.frame_size;
+    return handle->rx_pool.buffer + (index - 1) * handle->rx_pool.frame_size;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __rx_pool_switch_to(tiny_fd_handle_t handle, uint8_t index)
+{
+    int size;
+    uint8_t *buf = __rx_pool_frame(handle, index, &size);
+    handle->rx_pool.current = index;
+    handle->rx_pool.exhausted = 0;
+    hdlc_ll_set_rx_buffer(handle->_hdlc, buf, size);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __rx_pool_retain_current(tiny_fd_handle_t handle)
+{
+    // Must be called with frames.mutex locked
+    handle->rx_pool.retained |= (uint32_t)1 << handle->rx_pool.current;
+    for ( uint8_t index = 0; index <= handle->rx_pool.frames; index++ )
+    {
+        if ( !(handle->rx_pool.retained & ((uint32_t)1 << index)) )
+        {
+            __rx_pool_switch_to(handle, index);
+            return;
+        }
+    }
+    // hdlc level is not fed until some frame is released
+    handle->rx_pool.exhausted = 1;
+    tiny_events_clear(&handle->events, FD_EVENT_RX_POOL_HAS_ROOM);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __rx_pool_release(tiny_fd_handle_t handle, uint8_t index)
+{
+    // Must be called with frames.mutex locked
+    handle->rx_pool.retained &= ~((uint32_t)1 << index);
+    if ( handle->rx_pool.exhausted )
+    {
+        __rx_pool_switch_to(handle, index);
+        tiny_events_set(&handle->events, FD_EVENT_RX_POOL_HAS_ROOM);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool __rx_pool_hold_current(tiny_fd_handle_t handle, int len)
+{
+    // Must be called with frames.mutex locked
+    // The frame can be held only if hdlc level has some other buffer to decode next frames to
+    for ( uint8_t index = 0; index <= handle->rx_pool.frames; index++ )
+    {
+        if ( index != handle->rx_pool.current && !(handle->rx_pool.retained & ((uint32_t)1 << index)) )
+        {
+            handle->rx_pool.held |= (uint32_t)1 << handle->rx_pool.current;
+            handle->rx_pool.held_len[handle->rx_pool.current] = len;
+            __rx_pool_retain_current(handle);
+            return true;
+        }
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static uint8_t __rx_pool_find_held(tiny_fd_handle_t handle, uint8_t peer, uint8_t ns)
+{
+    // Must be called with frames.mutex locked. Any held frame of the peer matches ns == 0xFF
+    for ( uint8_t index = 0; index <= handle->rx_pool.frames; index++ )
+    {
+        if ( handle->rx_pool.held & ((uint32_t)1 << index) )
+        {
+            int size;
+            uint8_t *frame = __rx_pool_frame(handle, index, &size);
+            if ( __address_field_to_peer( handle, frame[0] ) == peer && (ns == 0xFF || __get_ns(handle, peer, frame) == ns) )
+            {
+                return index;
+            }
+        }
+    }
+    return 0xFF;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __rx_pool_drop_held(tiny_fd_handle_t handle, uint8_t peer)
+{
+    // Must be called with frames.mutex locked
+    uint8_t index;
+    while ( (index = __rx_pool_find_held(handle, peer, 0xFF)) != 0xFF )
+    {
+        handle->rx_pool.held &= ~((uint32_t)1 << index);
+        __rx_pool_release(handle, index);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static bool __is_ahead_of_expected_frame(tiny_fd_handle_t handle, uint8_t peer, uint8_t ns)
+{
+    // Remote window doesn't exceed half of sequence numbers space, if selective reject is used
+    const uint8_t mask = __seq_bits_mask(handle, peer);
+    return ((ns - handle->peers[peer].next_nr) & mask) < ((mask + 1) >> 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int __check_received_frame(tiny_fd_handle_t handle, uint8_t peer, uint8_t ns, int len)
 {
     int result = TINY_SUCCESS;
     if ( ns == handle->peers[peer].next_nr )
     {
         // this is what, we've been waiting for
         // LOG("[%p] Confirming received frame <= %d\n", handle, ns);
-        handle->peers[peer].next_nr = (handle->peers[peer].next_nr + 1) & seq_bits_mask;
+        handle->peers[peer].next_nr = (handle->peers[peer].next_nr + 1) & __seq_bits_mask(handle, peer);
         handle->peers[peer].sent_reject = 0;
     }
+    else if ( handle->srej && __is_ahead_of_expected_frame(handle, peer, ns) &&
+              (__rx_pool_find_held(handle, peer, ns) != 0xFF || __rx_pool_hold_current(handle, len)) )
+    {
+        // Keep the frame until the gap is filled, and request only the missing frame
+        LOG(TINY_LOG_ERR, "[%p] Out of order I-Frame N(s)=%d is held\n", handle, ns);
+        if ( !handle->peers[peer].sent_reject )
+        {
+            handle->peers[peer].sent_reject = 1;
+            __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT, HDLC_S_FRAME_TYPE_SREJ);
+        }
+        result = TINY_ERR_FAILED;
+    }
     else
     {
         // definitely we need to send reject. We want to see next_nr frame
         LOG(TINY_LOG_ERR, "[%p] Out of order I-Frame N(s)=%d\n", handle, ns);
         if ( !handle->peers[peer].sent_reject )
         {
-            tiny_frame_header_t frame = {
-                .address = __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
-                .control = HDLC_S_FRAME_BITS | HDLC_S_FRAME_TYPE_REJ | (handle->peers[peer].next_nr << 5),
-            };
             handle->peers[peer].sent_reject = 1;
-            __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, &frame, sizeof(tiny_frame_header_t));
+            __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT, HDLC_S_FRAME_TYPE_REJ);
+        }
+        else if ( handle->fast_retransmit )
+        {
+            // Duplicate acknowledgement allows the remote side to detect the loss, even if REJ is lost
+            __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ), HDLC_S_FRAME_TYPE_RR);
         }
         result = TINY_ERR_FAILED;
     }
@@ -309,7 +585,7 @@ static void __confirm_sent_frames(tiny_fd_handle_t handle, uint8_t peer, uint8_t
             if ( handle->on_sent_cb )
             {
                 tiny_mutex_unlock(&handle->frames.mutex);
-                handle->on_sent_cb(handle->user_data, &slot->payload[0], slot->len);
+                handle->on_sent_cb(handle->user_data, &slot->payload[slot->ext_control], slot->len);
                 tiny_mutex_lock(&handle->frames.mutex);
             }
             if ( handle->on_send_cb )
@@ -317,10 +593,18 @@ static void __confirm_sent_frames(tiny_fd_handle_t handle, uint8_t peer, uint8_t
                 tiny_mutex_unlock(&handle->frames.mutex);
                 handle->on_send_cb(handle->user_data,
                                    __is_primary_station( handle ) ? (__peer_to_address_field( handle, peer ) >> 2) : TINY_FD_PRIMARY_ADDR,
-                                   &slot->payload[0], slot->len);
+                                   &slot->payload[slot->ext_control], slot->len);
                 tiny_mutex_lock(&handle->frames.mutex);
             }
-            tiny_fd_queue_free( &handle->frames.i_queue, slot );
+            if ( slot->staged )
+            {
+                // hdlc level still reads the frame, the slot is released by on_frame_sent()
+                slot->type = TINY_FD_QUEUE_PINNED;
+            }
+            else
+            {
+                tiny_fd_queue_free( &handle->frames.i_queue, slot );
+            }
             if ( tiny_fd_queue_has_free_slots( &handle->frames.i_queue ) )
             {
                 // Unblock tx queue to allow application to put new frames for sending
@@ -333,9 +617,15 @@ static void __confirm_sent_frames(tiny_fd_handle_t handle, uint8_t peer, uint8_t
             // TODO: Add error processing
             LOG(TINY_LOG_ERR, "[%p] The frame cannot be confirmed: %02X\n", handle, handle->peers[peer].confirm_ns);
         }
-        handle->peers[peer].confirm_ns = (handle->peers[peer].confirm_ns + 1) & seq_bits_mask;
+        handle->peers[peer].confirm_ns = (handle->peers[peer].confirm_ns + 1) & __seq_bits_mask(handle, peer);
         handle->peers[peer].retries = handle->retries;
     }
+    if ( !__has_unconfirmed_frames( handle, peer ) )
+    {
+        // Nothing to recover, response to the checkpoint poll is not needed any more
+        handle->peers[peer].checkpoint = 0;
+        handle->peers[peer].poll_sent = 0;
+    }
     if ( __can_accept_i_frames( handle, peer ) )
     {
         // Unblock specific peer to accept new frames for sending
@@ -360,15 +650,17 @@ static void __resend_all_unconfirmed_frames(tiny_fd_handle_t handle, uint8_t pee
                 .header.address = __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
                 .header.control = HDLC_U_FRAME_TYPE_FRMR | HDLC_U_FRAME_BITS,
                 .data1 = control,
-                .data2 = (handle->peers[peer].next_nr << 5) | (handle->peers[peer].next_ns << 1),
+                .data2 = (uint8_t)((handle->peers[peer].next_nr << 5) | ((handle->peers[peer].next_ns << 1) & 0x0E)),
             };
-            // Send 2-byte header + 2 extra bytes
+            // Send 2-byte header + 2 extra bytes. For extended format only lower bits of sequence numbers fit the fields
             __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_U_FRAME, &frame, 4);
             break;
         }
-        handle->peers[peer].next_ns = (handle->peers[peer].next_ns - 1) & seq_bits_mask;
+        handle->peers[peer].next_ns = (handle->peers[peer].next_ns - 1) & __seq_bits_mask(handle, peer);
     }
     LOG(TINY_LOG_DEB, "[%p] N(s) is set to %02X\n", handle, handle->peers[peer].next_ns);
+    // Frames, staged after the rewound ones, must not go before them
+    handle->tx_flush = 1;
     tiny_events_set(&handle->events, FD_EVENT_TX_DATA_AVAILABLE);
 }
 
@@ -385,7 +677,13 @@ static void __switch_to_connected_state(tiny_fd_handle_t handle, uint8_t peer)
         handle->peers[peer].next_nr = 0;
         handle->peers[peer].sent_nr = 0;
         handle->peers[peer].sent_reject = 0;
+        handle->peers[peer].srej_pending = 0;
+        handle->peers[peer].dup_rr = 0;
+        handle->peers[peer].checkpoint = 0;
+        handle->peers[peer].poll_sent = 0;
+        __rx_pool_drop_held(handle, peer);
         tiny_fd_queue_reset_for( &handle->frames.i_queue, __peer_to_address_field( handle, peer ) );
+        handle->tx_flush = 1;
         handle->peers[peer].last_ka_ts = tiny_millis();
         tiny_events_set(&handle->peers[peer].events, FD_EVENT_CAN_ACCEPT_I_FRAMES);
         tiny_events_set(
@@ -417,7 +715,13 @@ static void __switch_to_disconnected_state(tiny_fd_handle_t handle, uint8_t peer
         handle->peers[peer].next_nr = 0;
         handle->peers[peer].sent_nr = 0;
         handle->peers[peer].sent_reject = 0;
+        handle->peers[peer].srej_pending = 0;
+        handle->peers[peer].dup_rr = 0;
+        handle->peers[peer].checkpoint = 0;
+        handle->peers[peer].poll_sent = 0;
+        __rx_pool_drop_held(handle, peer);
         tiny_fd_queue_reset_for( &handle->frames.i_queue, __peer_to_address_field( handle, peer ) );
+        handle->tx_flush = 1;
         tiny_events_clear(&handle->peers[peer].events, FD_EVENT_CAN_ACCEPT_I_FRAMES);
         LOG(TINY_LOG_CRIT, "[%p] Disconnected\n", handle);
         if ( handle->on_connect_event_cb )
@@ -433,41 +737,159 @@ static void __switch_to_disconnected_state(tiny_fd_handle_t handle, uint8_t peer
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static void __send_rr_if_needed(tiny_fd_handle_t handle, uint8_t peer)
+{
+    // Check if we need to send confirmations separately. If we have something to send, just skip RR S-frame.
+    // Also at this point, since we received expected frame, sent_reject will be cleared to 0.
+    if ( __all_frames_are_sent(handle, peer) && handle->peers[peer].sent_nr != handle->peers[peer].next_nr )
+    {
+        __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ), HDLC_S_FRAME_TYPE_RR);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __rx_batch_flush(tiny_fd_handle_t handle)
+{
+    // Must be called with frames.mutex locked
+    if ( !handle->rx_batch.count )
+    {
+        return;
+    }
+    tiny_mutex_unlock(&handle->frames.mutex);
+    handle->on_read_batch_cb(handle->user_data, handle->rx_batch.frames, handle->rx_batch.count);
+    tiny_mutex_lock(&handle->frames.mutex);
+    handle->rx_batch.count = 0;
+    for ( uint8_t index = 0; handle->rx_batch.pool_mask; index++ )
+    {
+        if ( handle->rx_batch.pool_mask & ((uint32_t)1 << index) )
+        {
+            handle->rx_batch.pool_mask &= ~((uint32_t)1 << index);
+            __rx_pool_release(handle, index);
+        }
+    }
+    // Single acknowledgement for all frames of the batch
+    for ( uint8_t peer = 0; peer < handle->peers_count; peer++ )
+    {
+        if ( handle->peers[peer].ack_pending )
+        {
+            handle->peers[peer].ack_pending = 0;
+            __send_rr_if_needed(handle, peer);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __rx_batch_add(tiny_fd_handle_t handle, uint8_t peer, uint8_t *data, int header_size, int len, uint8_t held)
+{
+    // Must be called with frames.mutex locked
+    tiny_fd_rx_frame_t *frame = &handle->rx_batch.frames[handle->rx_batch.count++];
+    frame->address = __is_primary_station( handle ) ? (__peer_to_address_field( handle, peer ) >> 2) : TINY_FD_PRIMARY_ADDR;
+    frame->data = data + header_size;
+    frame->len = len - header_size;
+    handle->peers[peer].ack_pending = 1;
+    // Frames, decoded in place, stay valid until the end of tiny_fd_on_rx_data(), while hdlc buffer is reused
+    bool keep = data != (uint8_t *)handle->_hdlc->rx_buf;
+    if ( held != 0xFF )
+    {
+        // Held frame is already retained in the pool, the batch just takes over the buffer
+        handle->rx_batch.pool_mask |= (uint32_t)1 << held;
+    }
+    else if ( !keep && handle->rx_pool.frames )
+    {
+        handle->rx_batch.pool_mask |= (uint32_t)1 << handle->rx_pool.current;
+        __rx_pool_retain_current(handle);
+        keep = !handle->rx_pool.exhausted;
+    }
+    if ( !keep || handle->rx_batch.count == CONFIG_TINY_FD_RX_BATCH_SIZE )
+    {
+        __rx_batch_flush(handle);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __deliver_i_frame(tiny_fd_handle_t handle, uint8_t peer, uint8_t *data, int len, uint8_t held)
+{
+    // Must be called with frames.mutex locked. held is index of rx pool buffer for held frames, 0xFF otherwise
+    const int header_size = __header_size(handle, peer, data);
+    bool retained = false;
+    if ( handle->on_read_batch_cb )
+    {
+        // Acknowledgement is sent, when the batch is delivered
+        __rx_batch_add(handle, peer, data, header_size, len, held);
+        return;
+    }
+    if ( handle->on_frame_cb )
+    {
+        tiny_mutex_unlock(&handle->frames.mutex);
+        handle->on_frame_cb(handle->user_data, data + header_size, len - header_size);
+        tiny_mutex_lock(&handle->frames.mutex);
+    }
+    if ( handle->on_read_cb )
+    {
+        tiny_mutex_unlock(&handle->frames.mutex);
+        handle->on_read_cb(handle->user_data,
+                           __is_primary_station( handle ) ? (__peer_to_address_field( handle, peer ) >> 2) : TINY_FD_PRIMARY_ADDR,
+                           data + header_size, len - header_size);
+        tiny_mutex_lock(&handle->frames.mutex);
+    }
+    if ( handle->on_rx_frame_cb )
+    {
+        tiny_mutex_unlock(&handle->frames.mutex);
+        int status = handle->on_rx_frame_cb(handle->user_data,
+                           __is_primary_station( handle ) ? (__peer_to_address_field( handle, peer ) >> 2) : TINY_FD_PRIMARY_ADDR,
+                           data + header_size, len - header_size);
+        tiny_mutex_lock(&handle->frames.mutex);
+        if ( status == TINY_FD_RX_RETAIN && handle->rx_pool.frames )
+        {
+            retained = true;
+            if ( held == 0xFF )
+            {
+                __rx_pool_retain_current(handle);
+            }
+        }
+    }
+    if ( held != 0xFF && !retained )
+    {
+        __rx_pool_release(handle, held);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static int __on_i_frame_read(tiny_fd_handle_t handle, uint8_t peer, void *data, int len)
 {
-    uint8_t control = ((uint8_t *)data)[1];
-    uint8_t nr = control >> 5;
-    uint8_t ns = (control >> 1) & 0x07;
+    uint8_t nr = __get_nr(handle, peer, (uint8_t *)data);
+    uint8_t ns = __get_ns(handle, peer, (uint8_t *)data);
     LOG(TINY_LOG_INFO, "[%p] Receiving I-Frame N(R)=%02X,N(S)=%02X with address [%02X]\n", handle, nr, ns, ((uint8_t *)data)[0]);
-    int result = __check_received_frame(handle, peer, ns);
+    int result = __check_received_frame(handle, peer, ns, len);
     __confirm_sent_frames(handle, peer, nr);
     // Provide data to user only if we expect this frame
     if ( result == TINY_SUCCESS )
     {
-        if ( handle->on_frame_cb )
+        __deliver_i_frame(handle, peer, (uint8_t *)data, len, 0xFF);
+        // Frames, held by selective reject, follow the received one
+        uint8_t held;
+        while ( handle->srej && (held = __rx_pool_find_held(handle, peer, handle->peers[peer].next_nr)) != 0xFF )
         {
-            tiny_mutex_unlock(&handle->frames.mutex);
-            handle->on_frame_cb(handle->user_data, (uint8_t *)data + 2, len - 2);
-            tiny_mutex_lock(&handle->frames.mutex);
+            int size;
+            uint8_t *frame = __rx_pool_frame(handle, held, &size);
+            handle->rx_pool.held &= ~((uint32_t)1 << held);
+            handle->peers[peer].next_nr = (handle->peers[peer].next_nr + 1) & __seq_bits_mask(handle, peer);
+            __deliver_i_frame(handle, peer, frame, handle->rx_pool.held_len[held], held);
         }
-        if ( handle->on_read_cb )
+        if ( handle->srej && __rx_pool_find_held(handle, peer, 0xFF) != 0xFF )
         {
-            tiny_mutex_unlock(&handle->frames.mutex);
-            handle->on_read_cb(handle->user_data,
-                               __is_primary_station( handle ) ? (__peer_to_address_field( handle, peer ) >> 2) : TINY_FD_PRIMARY_ADDR,
-                               (uint8_t *)data + 2, len - 2);
-            tiny_mutex_lock(&handle->frames.mutex);
+            // There is one more gap before remaining held frames
+            handle->peers[peer].sent_reject = 1;
+            __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT, HDLC_S_FRAME_TYPE_SREJ);
         }
-        // Decide whenever we need to send RR after user callback
-        // Check if we need to send confirmations separately. If we have something to send, just skip RR S-frame.
-        // Also at this point, since we received expected frame, sent_reject will be cleared to 0.
-        if ( __all_frames_are_sent(handle, peer) && handle->peers[peer].sent_nr != handle->peers[peer].next_nr )
+        else if ( !handle->on_read_batch_cb )
         {
-            tiny_frame_header_t frame = {
-                .address = __peer_to_address_field( handle, peer ),
-                .control = HDLC_S_FRAME_BITS | HDLC_S_FRAME_TYPE_RR | (handle->peers[peer].next_nr << 5),
-            };
-            __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, &frame, 2);
+            // Decide whenever we need to send RR after user callback
+            __send_rr_if_needed(handle, peer);
         }
     }
     return result;
@@ -479,28 +901,63 @@ static int __on_s_frame_read(tiny_fd_handle_t handle, uint8_t peer, void *data,
 {
     uint8_t address = ((uint8_t *)data)[0];
     uint8_t control = ((uint8_t *)data)[1];
-    uint8_t nr = control >> 5;
+    uint8_t nr = __get_nr(handle, peer, (uint8_t *)data);
     int result = TINY_ERR_FAILED;
     LOG(TINY_LOG_INFO, "[%p] Receiving S-Frame N(R)=%02X, type=%s with address [%02X]\n", handle, nr,
-        ((control >> 2) & 0x03) == 0x00 ? "RR" : "REJ", ((uint8_t *)data)[0]);
+        ((control >> 2) & 0x03) == 0x00 ? "RR" : (((control >> 2) & 0x03) == 0x03 ? "SREJ" : "REJ"), ((uint8_t *)data)[0]);
     if ( (control & HDLC_S_FRAME_TYPE_MASK) == HDLC_S_FRAME_TYPE_REJ )
     {
         __confirm_sent_frames(handle, peer, nr);
         __resend_all_unconfirmed_frames(handle, peer, control, nr);
+        // Duplicate RRs, following REJ, refer to the same loss
+        handle->peers[peer].dup_rr = handle->fast_retransmit;
+        // REJ carries N(R) of the remote side, so the checkpoint is complete
+        handle->peers[peer].checkpoint = 0;
+        handle->peers[peer].poll_sent = 0;
+    }
+    else if ( (control & HDLC_S_FRAME_TYPE_MASK) == HDLC_S_FRAME_TYPE_SREJ )
+    {
+        __confirm_sent_frames(handle, peer, nr);
+        // Only the frame, which was already sent, can be requested again
+        if ( handle->peers[peer].confirm_ns == nr && handle->peers[peer].next_ns != nr )
+        {
+            handle->peers[peer].srej_pending = 1;
+            handle->peers[peer].srej_ns = nr;
+            tiny_events_set(&handle->events, FD_EVENT_TX_DATA_AVAILABLE);
+        }
     }
     else if ( (control & HDLC_S_FRAME_TYPE_MASK) == HDLC_S_FRAME_TYPE_RR )
     {
+        const bool duplicate = nr == handle->peers[peer].confirm_ns && nr != handle->peers[peer].next_ns;
         __confirm_sent_frames(handle, peer, nr);
+        if ( !duplicate )
+        {
+            handle->peers[peer].dup_rr = 0;
+        }
+        else if ( handle->fast_retransmit && handle->peers[peer].dup_rr < handle->fast_retransmit &&
+                  ++handle->peers[peer].dup_rr == handle->fast_retransmit )
+        {
+            // Retransmit only once per loss, next time N(R) must move forward first
+            LOG(TINY_LOG_WRN, "[%p] Duplicate RR N(R)=%02X, resending unconfirmed frames\n", handle, nr);
+            __resend_all_unconfirmed_frames(handle, peer, control, nr);
+        }
         if ( address & HDLC_CR_BIT )
         {
-            // Send answer if we don't have frames to send
+            // Send answer if we don't have frames to send, otherwise next I-frame carries our N(R)
             if ( handle->peers[peer].next_ns == handle->peers[peer].last_ns )
             {
-                tiny_frame_header_t frame = {
-                    .address = __peer_to_address_field( handle, peer ),
-                    .control = HDLC_S_FRAME_BITS | HDLC_S_FRAME_TYPE_RR | (handle->peers[peer].next_nr << 5),
-                };
-                __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, &frame, 2);
+                __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ), HDLC_S_FRAME_TYPE_RR);
+            }
+        }
+        else if ( handle->peers[peer].poll_sent )
+        {
+            // The first response after the checkpoint poll went out answers it: everything below N(R) is delivered
+            handle->peers[peer].checkpoint = 0;
+            handle->peers[peer].poll_sent = 0;
+            if ( handle->peers[peer].next_ns != nr )
+            {
+                // The retry is already used up by the poll
+                __resend_all_unconfirmed_frames(handle, peer, control, nr);
             }
         }
     }
@@ -515,13 +972,29 @@ static int __on_u_frame_read(tiny_fd_handle_t handle, uint8_t peer, void *data,
     uint8_t type = control & HDLC_U_FRAME_TYPE_MASK;
     int result = TINY_ERR_FAILED;
     LOG(TINY_LOG_INFO, "[%p] Receiving U-Frame type=%02X with address [%02X]\n", handle, type, ((uint8_t *)data)[0]);
-    if ( type == HDLC_U_FRAME_TYPE_SABM || type == HDLC_U_FRAME_TYPE_SNRM )
+    if ( (type == HDLC_U_FRAME_TYPE_SABM || type == HDLC_U_FRAME_TYPE_SNRM) && handle->mode == TINY_FD_MODE_ABM &&
+         handle->frames.i_queue.size > 7 )
+    {
+        // Remote side requests modulo 8 sequence numbers, but our window needs extended format. Propose it back.
+        __put_set_mode_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
+                                         TINY_FD_QUEUE_U_FRAME);
+        handle->peers[peer].state = TINY_FD_STATE_CONNECTING;
+    }
+    else if ( type == HDLC_U_FRAME_TYPE_SABM || type == HDLC_U_FRAME_TYPE_SNRM ||
+              type == HDLC_U_FRAME_TYPE_SABME || type == HDLC_U_FRAME_TYPE_SNRME )
     {
+        const uint8_t extended = type == HDLC_U_FRAME_TYPE_SABME || type == HDLC_U_FRAME_TYPE_SNRME;
         tiny_frame_header_t frame = {
             .address = __peer_to_address_field( handle, peer ),
             .control = HDLC_U_FRAME_TYPE_UA | HDLC_U_FRAME_BITS,
         };
         __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_U_FRAME, &frame, 2);
+        if ( handle->peers[peer].extended != extended )
+        {
+            // Sequence numbers are reset, when the format of control field changes
+            handle->peers[peer].extended = extended;
+            handle->peers[peer].state = TINY_FD_STATE_CONNECTING;
+        }
         __switch_to_connected_state(handle, peer);
     }
     else if ( type == HDLC_U_FRAME_TYPE_DISC )
@@ -579,9 +1052,17 @@ static int on_frame_read(void *user_data, void *data, int len)
         return len;
     }
     tiny_mutex_lock(&handle->frames.mutex);
+    if ( len < __header_size( handle, peer, (uint8_t *)data ) )
+    {
+        tiny_mutex_unlock(&handle->frames.mutex);
+        LOG(TINY_LOG_WRN, "[%p] Received too small frame for the control field format\n", handle);
+        return TINY_ERR_FAILED;
+    }
     handle->peers[peer].last_ka_ts = tiny_millis();
     handle->peers[peer].ka_confirmed = 1;
     uint8_t control = ((uint8_t *)data)[1];
+    uint8_t poll = __get_pf_bit(handle, peer, (uint8_t *)data);
+    handle->peers[peer].rx_i_frames = (control & HDLC_I_FRAME_MASK) == HDLC_I_FRAME_BITS;
     if ( (control & HDLC_U_FRAME_MASK) == HDLC_U_FRAME_MASK )
     {
         __on_u_frame_read(handle, peer, data, len);
@@ -591,11 +1072,8 @@ static int on_frame_read(void *user_data, void *data, int len)
         // Should send DM in case we receive here S- or I-frames.
         // If connection is not established, we should ignore all frames except U-frames
         LOG(TINY_LOG_CRIT, "[%p] Connection is not established, connecting\n", handle);
-        tiny_frame_header_t frame = {
-            .address = __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
-            .control = (handle->mode == TINY_FD_MODE_NRM ? HDLC_U_FRAME_TYPE_SNRM : HDLC_U_FRAME_TYPE_SABM) | HDLC_U_FRAME_BITS,
-        };
-        __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_U_FRAME, &frame, 2);
+        __put_set_mode_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
+                                         TINY_FD_QUEUE_U_FRAME);
         handle->peers[peer].state = TINY_FD_STATE_CONNECTING;
     }
     else if ( (control & HDLC_I_FRAME_MASK) == HDLC_I_FRAME_BITS )
@@ -610,7 +1088,7 @@ static int on_frame_read(void *user_data, void *data, int len)
     {
         LOG(TINY_LOG_WRN, "[%p] Unknown hdlc frame received\n", handle);
     }
-    if ( control & HDLC_P_BIT )
+    if ( poll )
     {
         // Check that if we are in NRM mode then we have something to send
         if ( handle->mode == TINY_FD_MODE_NRM )
@@ -637,21 +1115,41 @@ static int on_frame_sent(void *user_data, const void *data, int len)
     tiny_mutex_lock(&handle->frames.mutex);
     if ( (control & HDLC_I_FRAME_MASK) == HDLC_I_FRAME_BITS )
     {
-        (void)(peer);
-        // nothing to do
-        // we need to wait for confirmation from remote side
+        // The slot is freed upon confirmation from remote side, unless it is already confirmed
+        tiny_fd_frame_info_t *frame = tiny_fd_queue_get_by_header( &handle->frames.i_queue, data );
+        if ( frame != NULL )
+        {
+            frame->staged = 0;
+            if ( frame->type == TINY_FD_QUEUE_PINNED )
+            {
+                tiny_fd_queue_free( &handle->frames.i_queue, frame );
+                tiny_events_set(&handle->events, FD_EVENT_QUEUE_HAS_FREE_SLOTS);
+            }
+            else
+            {
+                // Frame may be waiting for retransmission
+                tiny_events_set(&handle->events, FD_EVENT_TX_DATA_AVAILABLE);
+            }
+        }
     }
     else if ( (control & HDLC_S_FRAME_MASK) == HDLC_S_FRAME_BITS )
     {
+        if ( handle->peers[peer].checkpoint && (((const uint8_t *)data)[0] & HDLC_CR_BIT) &&
+             (control & HDLC_S_FRAME_TYPE_MASK) == HDLC_S_FRAME_TYPE_RR )
+        {
+            // Checkpoint poll is transmitted, responses sent by the remote side before it do not count
+            handle->peers[peer].poll_sent = 1;
+        }
         tiny_fd_queue_free_by_header( &handle->frames.s_queue, data );
     }
     else if ( (control & HDLC_U_FRAME_MASK) == HDLC_U_FRAME_BITS )
     {
         tiny_fd_queue_free_by_header( &handle->frames.s_queue, data );
     }
-    // Clear send flag and clear marker if final was transferred. For ABM mode the marker is never cleared
-    uint8_t flags = FD_EVENT_TX_SENDING;
-    if ( (control & HDLC_F_BIT) && handle->mode == TINY_FD_MODE_NRM )
+    // Clear send flag, if hdlc has no more frames staged, and clear marker if final was transferred.
+    // For ABM mode the marker is never cleared
+    uint8_t flags = handle->_hdlc->tx.origin_data ? 0 : FD_EVENT_TX_SENDING;
+    if ( __get_pf_bit(handle, peer, (const uint8_t *)data) && handle->mode == TINY_FD_MODE_NRM )
     {
         // Let's talk to the next station if we are primary
         // Of course, we could switch to the next peer upon receving response
@@ -675,25 +1173,34 @@ static int on_frame_sent(void *user_data, const void *data, int len)
 int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
 {
     const uint8_t peers_count = init->peers_count == 0 ? 1 : init->peers_count;
+    const int batch_size = init->on_read_batch_cb ? (int)(CONFIG_TINY_FD_RX_BATCH_SIZE * sizeof(tiny_fd_rx_frame_t)) : 0;
+    const int srej_size = (init->srej && init->rx_pool_buffer) ? (int)((init->rx_pool_frames + 1) * sizeof(uint16_t)) : 0;
     *handle = NULL;
-    if ( (0 == init->on_frame_cb && 0 == init->on_read_cb) || (0 == init->buffer) || (0 == init->buffer_size) )
+    if ( (0 == init->on_frame_cb && 0 == init->on_read_cb && 0 == init->on_rx_frame_cb && 0 == init->on_read_batch_cb) ||
+         (0 == init->buffer) || (0 == init->buffer_size) )
     {
         return TINY_ERR_FAILED;
     }
     if ( init->mtu == 0 )
     {
-        int size = tiny_fd_buffer_size_by_mtu_ex(peers_count, 0, init->window_frames, init->crc_type);
+        int size = tiny_fd_buffer_size_by_mtu_ex(peers_count, 0, init->window_frames, init->crc_type) + batch_size + srej_size;
         init->mtu = (init->buffer_size - size) / (init->window_frames + 1);
+        // I-frame slots are rounded up for alignment, so the estimate above can be slightly bigger than fits
+        while ( init->mtu > 0 && init->buffer_size < tiny_fd_buffer_size_by_mtu_ex(peers_count, init->mtu, init->window_frames,
+                                                                                      init->crc_type) + batch_size + srej_size )
+        {
+            init->mtu--;
+        }
         if ( init->mtu < 1 )
         {
             LOG(TINY_LOG_CRIT, "Calculated mtu size is zero, no payload transfer is available%c\n", ' ');
             return TINY_ERR_INVALID_DATA;
         }
     }
-    if ( init->buffer_size < tiny_fd_buffer_size_by_mtu_ex(peers_count, init->mtu, init->window_frames, init->crc_type) )
+    if ( init->buffer_size < tiny_fd_buffer_size_by_mtu_ex(peers_count, init->mtu, init->window_frames, init->crc_type) + batch_size + srej_size )
     {
         LOG(TINY_LOG_CRIT, "Too small buffer for FD protocol %i < %i\n", init->buffer_size,
-            tiny_fd_buffer_size_by_mtu_ex(peers_count, init->mtu, init->window_frames, init->crc_type));
+            tiny_fd_buffer_size_by_mtu_ex(peers_count, init->mtu, init->window_frames, init->crc_type) + batch_size + srej_size);
         return TINY_ERR_INVALID_DATA;
     }
     if ( init->window_frames < 2 )
@@ -701,11 +1208,42 @@ int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
         LOG(TINY_LOG_CRIT, "HDLC doesn't support less than 2-frames queue%c\n", ' ');
         return TINY_ERR_INVALID_DATA;
     }
+    if ( init->window_frames > 127 )
+    {
+        LOG(TINY_LOG_CRIT, "HDLC doesn't support more than 127-frames queue%c\n", ' ');
+        return TINY_ERR_INVALID_DATA;
+    }
     if ( !init->retry_timeout && !init->send_timeout )
     {
         LOG(TINY_LOG_CRIT, "HDLC uses timeouts for ACK, at least retry_timeout, or send_timeout must be specified%c\n", ' ');
         return TINY_ERR_INVALID_DATA;
     }
+    uint8_t *pipe_ptr = NULL;
+    int pipe_block_size = 0;
+    if ( init->tx_pipe_buffer )
+    {
+        pipe_ptr = TINY_ALIGN_BUFFER(init->tx_pipe_buffer);
+        pipe_block_size = init->tx_pipe_blocks < 2 ? 0 :
+                          (int)((uint8_t *)init->tx_pipe_buffer + init->tx_pipe_buffer_size - pipe_ptr) / init->tx_pipe_blocks;
+        pipe_block_size &= ~(TINY_ALIGN_STRUCT_VALUE - 1);
+        if ( pipe_block_size <= (int)sizeof(int) )
+        {
+            LOG(TINY_LOG_CRIT, "Too small tx pipe buffer or less than 2 blocks specified%c\n", ' ');
+            return TINY_ERR_INVALID_DATA;
+        }
+    }
+    int pool_frame_size = 0;
+    if ( init->rx_pool_buffer )
+    {
+        pool_frame_size = (init->rx_pool_frames < 1 || init->rx_pool_frames > 31) ? 0 :
+                          init->rx_pool_buffer_size / init->rx_pool_frames;
+        // Largest crc field is assumed here, since default crc type is not resolved yet
+        if ( pool_frame_size < init->mtu + (int)sizeof(tiny_frame_header_t) + TINY_FD_EXT_CONTROL_SIZE + 4 )
+        {
+            LOG(TINY_LOG_CRIT, "Too small rx pool buffer or wrong number of frames specified%c\n", ' ');
+            return TINY_ERR_INVALID_DATA;
+        }
+    }
     memset(init->buffer, 0, init->buffer_size);
 
     /* Lets locate main FD protocol data at the beginning of specified buffer.
@@ -720,18 +1258,20 @@ int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
     uint8_t *hdlc_ll_ptr = ptr;
     int hdlc_ll_size = (int)((uint8_t *)init->buffer + init->buffer_size - ptr - // Remaining size
                              init->window_frames *                               // Number of frames multiply by frame size (headers + payload + pointers)
-                                 ( sizeof(tiny_fd_frame_info_t *) + init->mtu + sizeof(tiny_fd_frame_info_t) - sizeof(((tiny_fd_frame_info_t *)0)->payload) ) -
+                                 ( sizeof(tiny_fd_frame_info_t *) + TINY_FD_QUEUE_SLOT_SIZE(init->mtu + TINY_FD_EXT_CONTROL_SIZE) ) -
+                             (TINY_ALIGN_STRUCT_VALUE - 1) - // I-frames queue may require alignment
                              TINY_FD_U_QUEUE_MAX_SIZE *
-                                 (sizeof(tiny_fd_frame_info_t *) + sizeof(tiny_fd_frame_info_t)) -
-                             peers_count * sizeof(tiny_fd_peer_info_t));
+                                 (sizeof(tiny_fd_frame_info_t *) + TINY_FD_QUEUE_SLOT_SIZE(2)) -
+                             peers_count * sizeof(tiny_fd_peer_info_t) - batch_size - srej_size);
     /* All FD protocol structures must be aligned. */
     hdlc_ll_size &= ~(TINY_ALIGN_STRUCT_VALUE - 1);
     ptr += hdlc_ll_size;
     ptr = TINY_ALIGN_BUFFER(ptr);
 
-    /* Next we need some space to hold pointers to tiny_i_frame_info_t records (window_frames pointers) */
+    /* Next we need some space to hold pointers to tiny_i_frame_info_t records (window_frames pointers).
+     * Each I-frame has room for the 2nd byte of extended control field, which precedes user payload. */
     int queue_size = tiny_fd_queue_init( &protocol->frames.i_queue, ptr, (int)((uint8_t *)init->buffer + init->buffer_size - ptr),
-                                         init->window_frames, init->mtu );
+                                         init->window_frames, init->mtu + TINY_FD_EXT_CONTROL_SIZE );
     if ( queue_size < 0 )
     {
         return queue_size;
@@ -753,6 +1293,15 @@ int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
     protocol->next_peer = 0;
     ptr += sizeof(tiny_fd_peer_info_t) * peers_count;
 
+    /* Batch of received frames is needed only if on_read_batch_cb is used */
+    ptr = TINY_ALIGN_BUFFER(ptr);
+    protocol->rx_batch.frames = (tiny_fd_rx_frame_t *)ptr;
+    ptr += batch_size;
+
+    /* Lengths of out-of-order frames, held in rx pool, are needed only if selective reject is enabled */
+    protocol->rx_pool.held_len = srej_size ? (uint16_t *)ptr : NULL;
+    ptr += srej_size;
+
     if ( ptr > (uint8_t *)init->buffer + init->buffer_size )
     {
         LOG(TINY_LOG_CRIT, "Out of provided memory: provided %i bytes, used %i bytes\n", init->buffer_size,
@@ -765,6 +1314,11 @@ int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
     _init.on_frame_sent = on_frame_sent;
     _init.user_data = protocol;
     _init.crc_type = init->crc_type;
+    _init.framing = init->framing;
+    // Frames, decoded in place, belong to the caller of tiny_fd_on_rx_data() and cannot be retained
+    _init.zero_copy_rx = init->zero_copy_rx && !pool_frame_size;
+    // Anything shorter than address and control fields is line noise, not a frame
+    _init.min_frame_len = sizeof(tiny_frame_header_t);
     _init.buf_size = hdlc_ll_size;
     _init.buf = hdlc_ll_ptr;
 
@@ -780,11 +1334,25 @@ int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
     protocol->on_sent_cb = init->on_sent_cb;
     protocol->on_read_cb = init->on_read_cb;
     protocol->on_send_cb = init->on_send_cb;
+    protocol->on_rx_frame_cb = init->on_rx_frame_cb;
+    protocol->on_read_batch_cb = init->on_read_batch_cb;
     protocol->on_connect_event_cb = init->on_connect_event_cb;
     protocol->send_timeout = init->send_timeout;
     // By default assign primary address
     protocol->addr = (init->addr ? (init->addr << 2) : HDLC_PRIMARY_ADDR ) | HDLC_E_BIT;
     protocol->mode = init->mode;
+    protocol->cache_crc = init->cache_crc && get_crc_field_size(protocol->_hdlc->crc_type) > 0;
+    protocol->tx_pipe.buffer = pipe_ptr;
+    protocol->tx_pipe.block_size = pipe_block_size;
+    protocol->tx_pipe.blocks = pipe_ptr ? init->tx_pipe_blocks : 0;
+    protocol->rx_pool.buffer = (uint8_t *)init->rx_pool_buffer;
+    protocol->rx_pool.frame_size = pool_frame_size;
+    protocol->rx_pool.frames = pool_frame_size ? init->rx_pool_frames : 0;
+    protocol->rx_pool.hdlc_buf = protocol->_hdlc->rx_buf;
+    protocol->rx_pool.hdlc_buf_size = protocol->_hdlc->rx_buf_size;
+    protocol->srej = srej_size != 0;
+    protocol->fast_nak = init->fast_nak;
+    protocol->fast_retransmit = init->fast_retransmit;
     // Primary devices always have markers
     protocol->ka_timeout = 5000;
     protocol->retry_timeout =
@@ -812,6 +1380,12 @@ int tiny_fd_init(tiny_fd_handle_t *handle, tiny_fd_init_t *init)
     tiny_events_create(&protocol->events);
     tiny_events_set( &protocol->events, FD_EVENT_QUEUE_HAS_FREE_SLOTS |
                                         (__is_primary_station( protocol ) ? FD_EVENT_HAS_MARKER : 0) );
+    if ( protocol->tx_pipe.blocks )
+    {
+        tiny_mutex_create(&protocol->tx_pipe.mutex);
+        tiny_events_set( &protocol->events, FD_EVENT_TX_PIPE_HAS_ROOM );
+    }
+    tiny_events_set( &protocol->events, FD_EVENT_RX_POOL_HAS_ROOM );
     *handle = protocol;
 
     return TINY_SUCCESS;
@@ -828,6 +1402,25 @@ void tiny_fd_close(tiny_fd_handle_t handle)
     }
     tiny_events_destroy(&handle->events);
     tiny_mutex_destroy(&handle->frames.mutex);
+    if ( handle->tx_pipe.blocks )
+    {
+        tiny_mutex_destroy(&handle->tx_pipe.mutex);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void __send_fast_reject(tiny_fd_handle_t handle)
+{
+    // Must be called with frames.mutex locked
+    // Address field of the broken frame cannot be trusted, so only single peer link is known for sure
+    if ( handle->peers_count == 1 && handle->peers[0].state == TINY_FD_STATE_CONNECTED && handle->peers[0].rx_i_frames &&
+         !handle->peers[0].sent_reject )
+    {
+        // The broken frame might be the I-frame we wait for. Ask for it without waiting for retry timeout
+        handle->peers[0].sent_reject = 1;
+        __put_s_frame_to_tx_queue(handle, 0, __peer_to_address_field( handle, 0 ) | HDLC_CR_BIT, HDLC_S_FRAME_TYPE_REJ);
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -835,18 +1428,66 @@ void tiny_fd_close(tiny_fd_handle_t handle)
 int tiny_fd_on_rx_data(tiny_fd_handle_t handle, const void *data, int len)
 {
     const uint8_t *ptr = (const uint8_t *)data;
+    int result = TINY_SUCCESS;
     while ( len )
     {
+        if ( handle->rx_pool.exhausted &&
+             !tiny_events_wait(&handle->events, FD_EVENT_RX_POOL_HAS_ROOM, EVENT_BITS_LEAVE, handle->retry_timeout) )
+        {
+            // Dropped frames will be retransmitted by the remote side
+            LOG(TINY_LOG_WRN, "[%p] All rx buffers are retained, dropping %i bytes\n", handle, len);
+            result = TINY_ERR_BUSY;
+            break;
+        }
         int error;
         int processed_bytes = hdlc_ll_run_rx(handle->_hdlc, ptr, len, &error);
         if ( error == TINY_ERR_WRONG_CRC )
         {
             LOG(TINY_LOG_WRN, "[%p] HDLC CRC sum mismatch\n", handle);
         }
+        if ( handle->fast_nak && (error == TINY_ERR_WRONG_CRC || error == TINY_ERR_DATA_TOO_LARGE) )
+        {
+            tiny_mutex_lock(&handle->frames.mutex);
+            __send_fast_reject(handle);
+            tiny_mutex_unlock(&handle->frames.mutex);
+        }
         ptr += processed_bytes;
         len -= processed_bytes;
     }
-    return TINY_SUCCESS;
+    if ( handle->rx_batch.count )
+    {
+        tiny_mutex_lock(&handle->frames.mutex);
+        __rx_batch_flush(handle);
+        tiny_mutex_unlock(&handle->frames.mutex);
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int tiny_fd_release_rx(tiny_fd_handle_t handle, uint8_t *pdata)
+{
+    int result = TINY_ERR_INVALID_DATA;
+    tiny_mutex_lock(&handle->frames.mutex);
+    for ( uint8_t index = 0; index <= handle->rx_pool.frames; index++ )
+    {
+        int size;
+        uint8_t *frame = __rx_pool_frame(handle, index, &size);
+        if ( !(handle->rx_pool.retained & ~handle->rx_batch.pool_mask & ~handle->rx_pool.held & ((uint32_t)1 << index)) )
+        {
+            continue;
+        }
+        // Frame payload follows the header in the buffer, header size depends on control field format of the link
+        uint8_t peer = __address_field_to_peer( handle, frame[0] );
+        if ( peer != 0xFF && frame + __header_size(handle, peer, frame) == pdata )
+        {
+            __rx_pool_release(handle, index);
+            result = TINY_SUCCESS;
+            break;
+        }
+    }
+    tiny_mutex_unlock(&handle->frames.mutex);
+    return result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -876,7 +1517,7 @@ static uint8_t *tiny_fd_get_next_s_u_frame_to_send(tiny_fd_handle_t handle, int
         *len = ptr->len + sizeof(tiny_frame_header_t);
         if ( (data[1] & HDLC_S_FRAME_MASK) == HDLC_S_FRAME_BITS )
         {
-            handle->peers[peer].sent_nr = ptr->header.control >> 5;
+            handle->peers[peer].sent_nr = __get_nr(handle, peer, data);
         }
 #if TINY_FD_DEBUG
         if ( (data[1] & HDLC_U_FRAME_MASK) == HDLC_U_FRAME_BITS )
@@ -886,8 +1527,8 @@ static uint8_t *tiny_fd_get_next_s_u_frame_to_send(tiny_fd_handle_t handle, int
         }
         else if ( (data[1] & HDLC_S_FRAME_MASK) == HDLC_S_FRAME_BITS )
         {
-            LOG(TINY_LOG_INFO, "[%p] Sending S-Frame N(R)=%02X, type=%s with address [%02X] to %s\n", handle, data[1] >> 5,
-                ((data[1] >> 2) & 0x03) == 0x00 ? "RR" : "REJ", data[0],  __is_primary_station( handle ) ? "secondary" : "primary");
+            LOG(TINY_LOG_INFO, "[%p] Sending S-Frame N(R)=%02X, type=%s with address [%02X] to %s\n", handle, __get_nr(handle, peer, data),
+                ((data[1] >> 2) & 0x03) == 0x00 ? "RR" : (((data[1] >> 2) & 0x03) == 0x03 ? "SREJ" : "REJ"), data[0],  __is_primary_station( handle ) ? "secondary" : "primary");
         }
 #endif
     }
@@ -900,22 +1541,55 @@ static uint8_t *tiny_fd_get_next_i_frame(tiny_fd_handle_t handle, int *len, uint
 {
     uint8_t *data = NULL;
     tiny_fd_frame_info_t *ptr = NULL;
+    bool resend = false;
     if ( handle->peers[peer].state == TINY_FD_STATE_DISCONNECTED || handle->peers[peer].state == TINY_FD_STATE_CONNECTING )
     {
         // If sending of I-frames is not allowed then just exit
         return NULL;
     }
-    ptr = tiny_fd_queue_get_next( &handle->frames.i_queue, TINY_FD_QUEUE_I_FRAME, address, handle->peers[peer].next_ns );
+    if ( handle->peers[peer].srej_pending )
+    {
+        // Frame, requested by selective reject, is retransmitted alone, without rewinding N(S)
+        handle->peers[peer].srej_pending = 0;
+        ptr = tiny_fd_queue_get_next( &handle->frames.i_queue, TINY_FD_QUEUE_I_FRAME, address, handle->peers[peer].srej_ns );
+        // Frame, which is still staged to hdlc level, is on the way already
+        resend = ptr != NULL && !ptr->staged;
+        if ( !resend )
+        {
+            ptr = NULL;
+        }
+    }
+    if ( ptr == NULL )
+    {
+        ptr = tiny_fd_queue_get_next( &handle->frames.i_queue, TINY_FD_QUEUE_I_FRAME, address, handle->peers[peer].next_ns );
+        if ( ptr != NULL && ptr->staged )
+        {
+            // Rewound frame is still being sent, wait until hdlc level reports it
+            return NULL;
+        }
+    }
     if ( ptr != NULL )
     {
         data = (uint8_t *)&ptr->header;
-        *len = ptr->len + sizeof(tiny_frame_header_t);
+        *len = ptr->len + ptr->ext_control + sizeof(tiny_frame_header_t);
         LOG(TINY_LOG_INFO, "[%p] Sending I-Frame N(R)=%02X,N(S)=%02X with address [%02X] to %s\n", handle, handle->peers[peer].next_nr,
-            handle->peers[peer].next_ns, data[0], __is_primary_station( handle ) ? "secondary" : "primary" );
-        ptr->header.control &= 0x0F;
-        ptr->header.control |= (handle->peers[peer].next_nr << 5);
-        handle->peers[peer].next_ns++;
-        handle->peers[peer].next_ns &= seq_bits_mask;
+            __get_ns(handle, peer, data), data[0], __is_primary_station( handle ) ? "secondary" : "primary" );
+        if ( ptr->ext_control )
+        {
+            ptr->payload[0] = handle->peers[peer].next_nr << 1;
+        }
+        else
+        {
+            ptr->header.control &= 0x0F;
+            ptr->header.control |= (handle->peers[peer].next_nr << 5);
+        }
+        if ( !resend )
+        {
+            handle->peers[peer].next_ns++;
+            handle->peers[peer].next_ns &= __seq_bits_mask(handle, peer);
+        }
+        // Frame goes to hdlc level, slot must not be freed or staged again until hdlc level reports it as sent
+        ptr->staged = 1;
         // Move to different place
         handle->peers[peer].sent_nr = handle->peers[peer].next_nr;
         handle->peers[peer].last_i_ts = tiny_millis();
@@ -943,26 +1617,17 @@ static uint8_t *tiny_fd_get_next_frame_to_send(tiny_fd_handle_t handle, int *len
         if ( __is_primary_station( handle ) &&
             ( handle->peers[peer].state == TINY_FD_STATE_DISCONNECTED || handle->peers[peer].state == TINY_FD_STATE_CONNECTING))
         {
-            tiny_frame_header_t frame = {
-                .address = address,
-                .control = HDLC_U_FRAME_TYPE_SNRM | HDLC_U_FRAME_BITS,
-            };
-            __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, &frame, 2);
+            __put_set_mode_frame_to_tx_queue(handle, peer, address, TINY_FD_QUEUE_S_FRAME);
         }
         else
         {
-            tiny_frame_header_t frame = {
-                .address = address,
-                .control = HDLC_S_FRAME_BITS | HDLC_S_FRAME_TYPE_RR | (handle->peers[peer].next_nr << 5),
-            };
-            __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, &frame, 2);
+            __put_s_frame_to_tx_queue(handle, peer, address, HDLC_S_FRAME_TYPE_RR);
         }
         data = tiny_fd_get_next_s_u_frame_to_send(handle, len, peer, address);
     }
     if ( data != NULL )
     {
-        tiny_frame_header_t *header = (tiny_frame_header_t *)data;
-        header->control |= HDLC_P_BIT;
+        __set_poll_bit(handle, peer, data);
         handle->last_marker_ts = tiny_millis();
         handle->peers[peer].last_ka_ts = tiny_millis();
     }
@@ -972,6 +1637,50 @@ static uint8_t *tiny_fd_get_next_frame_to_send(tiny_fd_handle_t handle, int *len
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static int tiny_fd_put_frame_to_hdlc(tiny_fd_handle_t handle, uint8_t *data, int len)
+{
+    // All frames to send are located in the queues, right after frame info fields
+    tiny_fd_frame_info_t *frame = (tiny_fd_frame_info_t *)(data - offsetof(tiny_fd_frame_info_t, header));
+    if ( handle->cache_crc && frame->type == TINY_FD_QUEUE_I_FRAME )
+    {
+        // Header is changed on every send (N(R) and P bit), but payload is not
+        hdlc_crc_t crc_type = handle->_hdlc->crc_type;
+        uint32_t crc = hdlc_ll_crc_combine(crc_type, hdlc_ll_crc(crc_type, data, sizeof(tiny_frame_header_t) + frame->ext_control),
+                                           frame->crc, frame->len);
+        return hdlc_ll_put_with_crc(handle->_hdlc, data, len, crc);
+    }
+    return hdlc_ll_put(handle->_hdlc, data, len);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static void tiny_fd_stage_next_i_frame(tiny_fd_handle_t handle, uint8_t peer)
+{
+    // Queue next I-frame to hdlc level while current frame is being sent, so that frames go
+    // back to back sharing the flag. Marker and S/U-frames logic is kept for the main path.
+    if ( handle->mode != TINY_FD_MODE_ABM || handle->_hdlc->tx.queue_len >= CONFIG_HDLC_LL_TX_QUEUE_SIZE )
+    {
+        return;
+    }
+    tiny_mutex_lock(&handle->frames.mutex);
+    const uint8_t address = __peer_to_address_field( handle, peer );
+    if ( tiny_fd_queue_get_next( &handle->frames.s_queue, TINY_FD_QUEUE_S_FRAME | TINY_FD_QUEUE_U_FRAME, address, 0 ) == NULL )
+    {
+        int len = 0;
+        uint8_t *data = tiny_fd_get_next_i_frame(handle, &len, peer, address);
+        if ( data != NULL )
+        {
+            __set_poll_bit(handle, peer, data);
+            handle->last_marker_ts = tiny_millis();
+            handle->peers[peer].last_ka_ts = tiny_millis();
+            tiny_fd_put_frame_to_hdlc(handle, data, len);
+        }
+    }
+    tiny_mutex_unlock(&handle->frames.mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 static void tiny_fd_connected_check_idle_timeout(tiny_fd_handle_t handle, uint8_t peer)
 {
     tiny_mutex_lock(&handle->frames.mutex);
@@ -986,9 +1695,25 @@ static void tiny_fd_connected_check_idle_timeout(tiny_fd_handle_t handle, uint8_
                 "[%p] Timeout, resending unconfirmed frames: last(%" PRIu32 " ms, now(%" PRIu32 " ms), timeout(%" PRIu16
                 " ms))\n",
                 handle, handle->peers[peer].last_i_ts, tiny_millis(), handle->retry_timeout);
-            handle->peers[peer].retries--;
-            // Do not use mutex for confirm_ns value as it is byte-value
-            __resend_all_unconfirmed_frames(handle, peer, 0, handle->peers[peer].confirm_ns);
+            if ( !handle->peers[peer].checkpoint && handle->peers[peer].retries == handle->retries )
+            {
+                // Often only acknowledgement is lost. Ask the remote side, which frames are actually missing.
+                // The poll is sent once per loss instead of the first retransmission, and uses up a retry
+                handle->peers[peer].checkpoint = 1;
+                handle->peers[peer].retries--;
+                handle->peers[peer].last_i_ts = tiny_millis();
+                __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
+                                          HDLC_S_FRAME_TYPE_RR);
+            }
+            else
+            {
+                // No response to the checkpoint poll or the poll is already used, resend all unconfirmed frames
+                handle->peers[peer].checkpoint = 0;
+                handle->peers[peer].poll_sent = 0;
+                handle->peers[peer].retries--;
+                // Do not use mutex for confirm_ns value as it is byte-value
+                __resend_all_unconfirmed_frames(handle, peer, 0, handle->peers[peer].confirm_ns);
+            }
         }
         else
         {
@@ -1006,12 +1731,8 @@ static void tiny_fd_connected_check_idle_timeout(tiny_fd_handle_t handle, uint8_
         else
         {
             // Nothing to send, all frames are confirmed, just send keep alive
-            tiny_frame_header_t frame = {
-                .address = __peer_to_address_field( handle, peer ),
-                .control = HDLC_S_FRAME_BITS | HDLC_S_FRAME_TYPE_RR | (handle->peers[peer].next_nr << 5),
-            };
             handle->peers[peer].ka_confirmed = 0;
-            __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_S_FRAME, &frame, 2);
+            __put_s_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ), HDLC_S_FRAME_TYPE_RR);
         }
         handle->peers[peer].last_ka_ts = tiny_millis();
     }
@@ -1030,11 +1751,8 @@ static void tiny_fd_disconnected_check_idle_timeout(tiny_fd_handle_t handle, uin
             LOG(TINY_LOG_ERR, "[%p] Connection is not established, connecting to peer %02X [addr:%02X]\n", handle,
                    handle->next_peer, __peer_to_address_field( handle, peer ));
             // Try to establish Connection
-            tiny_frame_header_t frame = {
-                .address = __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
-                .control = (handle->mode == TINY_FD_MODE_NRM ? HDLC_U_FRAME_TYPE_SNRM : HDLC_U_FRAME_TYPE_SABM) | HDLC_U_FRAME_BITS,
-            };
-            if ( __put_u_s_frame_to_tx_queue(handle, TINY_FD_QUEUE_U_FRAME, &frame, 2) == NULL )
+            if ( __put_set_mode_frame_to_tx_queue(handle, peer, __peer_to_address_field( handle, peer ) | HDLC_CR_BIT,
+                                                  TINY_FD_QUEUE_U_FRAME) == NULL )
             {
                 LOG(TINY_LOG_CRIT, "[%p] Failed to queue SNRM/SABM message for peer %02X [addr:%02X]\n", handle,
                        handle->next_peer, __peer_to_address_field( handle, peer ));
@@ -1057,9 +1775,16 @@ int tiny_fd_get_tx_data(tiny_fd_handle_t handle, void *data, int len)
     while ( result < len )
     {
         int generated_data = 0;
+        if ( handle->tx_flush )
+        {
+            // Dropped I-frames are staged again in N(S) order after rewind
+            handle->tx_flush = 0;
+            hdlc_ll_flush(handle->_hdlc);
+        }
         // Check if send on hdlc level operation is in progress and do some work
         if ( tiny_events_wait(&handle->events, FD_EVENT_TX_SENDING, EVENT_BITS_LEAVE, 0) )
         {
+            tiny_fd_stage_next_i_frame(handle, peer);
             generated_data = hdlc_ll_run_tx(handle->_hdlc, ((uint8_t *)data) + result, len - result);
         }
         else
@@ -1093,7 +1818,7 @@ int tiny_fd_get_tx_data(tiny_fd_handle_t handle, void *data, int len)
                         // Do not use timeout for hdlc_send(), as hdlc level is ready to accept next frame
                         // (FD_EVENT_TX_SENDING is not set). And at this step we do not need hdlc_send() to
                         // send data.
-                        hdlc_ll_put(handle->_hdlc, frame_data, frame_len);
+                        tiny_fd_put_frame_to_hdlc(handle, frame_data, frame_len);
                         continue;
                     }
                     else if ( handle->mode == TINY_FD_MODE_ABM || __is_secondary_station( handle ) )
@@ -1163,7 +1888,82 @@ int tiny_fd_run_tx(tiny_fd_handle_t handle, write_block_cb_t write_func)
 
 ///////////////////////////////////////////////////////////////////////////////
 
-int tiny_fd_send_packet_to(tiny_fd_handle_t handle, uint8_t address, const void *data, int len)
+int tiny_fd_tx_encode(tiny_fd_handle_t handle, uint32_t timeout)
+{
+    tiny_fd_tx_pipe_t *pipe = &handle->tx_pipe;
+    if ( !pipe->blocks )
+    {
+        return TINY_ERR_FAILED;
+    }
+    if ( !tiny_events_wait(&handle->events, FD_EVENT_TX_PIPE_HAS_ROOM, EVENT_BITS_LEAVE, timeout) )
+    {
+        return TINY_ERR_TIMEOUT;
+    }
+    // Head block is owned by the encoder until it is committed, so no lock is needed here
+    uint8_t *block = pipe->buffer + pipe->head * pipe->block_size;
+    int len = tiny_fd_get_tx_data(handle, block + sizeof(int), pipe->block_size - (int)sizeof(int));
+    if ( len > 0 )
+    {
+        *(int *)block = len;
+        tiny_mutex_lock(&pipe->mutex);
+        pipe->head = (uint8_t)((pipe->head + 1) % pipe->blocks);
+        pipe->count++;
+        if ( pipe->count == pipe->blocks )
+        {
+            tiny_events_clear(&handle->events, FD_EVENT_TX_PIPE_HAS_ROOM);
+        }
+        tiny_events_set(&handle->events, FD_EVENT_TX_PIPE_HAS_DATA);
+        tiny_mutex_unlock(&pipe->mutex);
+    }
+    return len;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int tiny_fd_tx_acquire(tiny_fd_handle_t handle, const void **data, uint32_t timeout)
+{
+    tiny_fd_tx_pipe_t *pipe = &handle->tx_pipe;
+    if ( !pipe->blocks )
+    {
+        return TINY_ERR_FAILED;
+    }
+    if ( !tiny_events_wait(&handle->events, FD_EVENT_TX_PIPE_HAS_DATA, EVENT_BITS_LEAVE, timeout) )
+    {
+        return TINY_ERR_TIMEOUT;
+    }
+    // Tail block cannot be reused by the encoder until it is released
+    uint8_t *block = pipe->buffer + pipe->tail * pipe->block_size;
+    *data = block + sizeof(int);
+    return *(int *)block;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void tiny_fd_tx_release(tiny_fd_handle_t handle)
+{
+    tiny_fd_tx_pipe_t *pipe = &handle->tx_pipe;
+    if ( !pipe->blocks )
+    {
+        return;
+    }
+    tiny_mutex_lock(&pipe->mutex);
+    if ( pipe->count )
+    {
+        pipe->tail = (uint8_t)((pipe->tail + 1) % pipe->blocks);
+        pipe->count--;
+        if ( !pipe->count )
+        {
+            tiny_events_clear(&handle->events, FD_EVENT_TX_PIPE_HAS_DATA);
+        }
+        tiny_events_set(&handle->events, FD_EVENT_TX_PIPE_HAS_ROOM);
+    }
+    tiny_mutex_unlock(&pipe->mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int __allocate_i_frame(tiny_fd_handle_t handle, uint8_t address, const void *data, int len, uint32_t timeout,
+                              uint8_t **payload)
 {
     int result;
     uint8_t peer;
@@ -1182,22 +1982,21 @@ int tiny_fd_send_packet_to(tiny_fd_handle_t handle, uint8_t address, const void
     // Check frame size againts mtu
     // MTU doesn't include header and crc fields, only user payload
     uint32_t start_ms = tiny_millis();
-    if ( len > tiny_fd_queue_get_mtu( &handle->frames.i_queue ) )
+    if ( len > tiny_fd_get_mtu( handle ) )
     {
-        LOG(TINY_LOG_ERR, "[%p] PUT frame error: len: %d, mtu:%d\n", handle, len, tiny_fd_queue_get_mtu( &handle->frames.i_queue ));
+        LOG(TINY_LOG_ERR, "[%p] PUT frame error: len: %d, mtu:%d\n", handle, len, tiny_fd_get_mtu( handle ));
         result = TINY_ERR_DATA_TOO_LARGE;
     }
     // Wait until there is room for new frame
-    else if ( tiny_events_wait(&handle->peers[peer].events, FD_EVENT_CAN_ACCEPT_I_FRAMES, EVENT_BITS_CLEAR,
-                               handle->send_timeout) )
+    else if ( tiny_events_wait(&handle->peers[peer].events, FD_EVENT_CAN_ACCEPT_I_FRAMES, EVENT_BITS_CLEAR, timeout) )
     {
         uint32_t delta_ms = (uint32_t)(tiny_millis() - start_ms);
         if ( tiny_events_wait(&handle->events, FD_EVENT_QUEUE_HAS_FREE_SLOTS, EVENT_BITS_CLEAR,
-                               handle->send_timeout > delta_ms ? (handle->send_timeout - delta_ms) : 0) )
+                               timeout > delta_ms ? (timeout - delta_ms) : 0) )
         {
             tiny_mutex_lock(&handle->frames.mutex);
             // Check if space is actually available
-            if ( __put_i_frame_to_tx_queue(handle, peer, data, len) )
+            if ( payload ? __reserve_i_frame(handle, peer, len, payload) : __put_i_frame_to_tx_queue(handle, peer, data, len) )
             {
                 if ( tiny_fd_queue_has_free_slots( &handle->frames.i_queue ) )
                 {
@@ -1243,6 +2042,57 @@ int tiny_fd_send_packet_to(tiny_fd_handle_t handle, uint8_t address, const void
 
 ///////////////////////////////////////////////////////////////////////////////
 
+int tiny_fd_send_packet_to(tiny_fd_handle_t handle, uint8_t address, const void *data, int len)
+{
+    return __allocate_i_frame(handle, address, data, len, handle->send_timeout, NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void *tiny_fd_reserve_packet(tiny_fd_handle_t handle, uint8_t address, int len, uint32_t timeout)
+{
+    uint8_t *payload = NULL;
+    if ( len <= 0 || __allocate_i_frame(handle, address, NULL, len, timeout, &payload) != TINY_SUCCESS )
+    {
+        return NULL;
+    }
+    return payload;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+int tiny_fd_commit_packet(tiny_fd_handle_t handle, void *data, int len)
+{
+    int result = TINY_ERR_INVALID_DATA;
+    tiny_mutex_lock(&handle->frames.mutex);
+    tiny_fd_frame_info_t *slot = tiny_fd_queue_get_by_payload(&handle->frames.i_queue, TINY_FD_QUEUE_RESERVED, data);
+    if ( slot != NULL && len >= 0 && len <= slot->len )
+    {
+        uint8_t peer = __address_field_to_peer( handle, slot->header.address );
+        handle->peers[peer].reserved--;
+        if ( len )
+        {
+            slot->len = len;
+            __commit_i_frame(handle, peer, slot);
+        }
+        else
+        {
+            // Reservation is cancelled
+            tiny_fd_queue_free(&handle->frames.i_queue, slot);
+            tiny_events_set(&handle->events, FD_EVENT_QUEUE_HAS_FREE_SLOTS);
+        }
+        if ( __can_accept_i_frames( handle, peer ) )
+        {
+            tiny_events_set(&handle->peers[peer].events, FD_EVENT_CAN_ACCEPT_I_FRAMES);
+        }
+        result = TINY_SUCCESS;
+    }
+    tiny_mutex_unlock(&handle->frames.mutex);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 int tiny_fd_send_packet(tiny_fd_handle_t handle, const void *data, int len)
 {
     return tiny_fd_send_packet_to(handle, TINY_FD_PRIMARY_ADDR, data, len);
@@ -1267,12 +2117,11 @@ int tiny_fd_buffer_size_by_mtu_ex(uint8_t peers_count, int mtu, int window, hdlc
     return sizeof(tiny_fd_data_t) + TINY_ALIGN_STRUCT_VALUE - 1 +
            peers_count * sizeof(tiny_fd_peer_info_t) +
            // RX side
-           hdlc_ll_get_buf_size_ex(mtu + sizeof(tiny_frame_header_t), crc_type) +
+           hdlc_ll_get_buf_size_ex(mtu + sizeof(tiny_frame_header_t) + TINY_FD_EXT_CONTROL_SIZE, crc_type) +
            // TX side
-           (sizeof(tiny_fd_frame_info_t *) + sizeof(tiny_fd_frame_info_t) + mtu -
-            sizeof(((tiny_fd_frame_info_t *)0)->payload)) *
-               window +
-           (sizeof(tiny_fd_frame_info_t *) + sizeof(tiny_fd_frame_info_t)) * TINY_FD_U_QUEUE_MAX_SIZE;
+           (sizeof(tiny_fd_frame_info_t *) + TINY_FD_QUEUE_SLOT_SIZE(mtu + TINY_FD_EXT_CONTROL_SIZE)) * window +
+           TINY_ALIGN_STRUCT_VALUE - 1 +
+           (sizeof(tiny_fd_frame_info_t *) + TINY_FD_QUEUE_SLOT_SIZE(2)) * TINY_FD_U_QUEUE_MAX_SIZE;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1286,7 +2135,8 @@ void tiny_fd_set_ka_timeout(tiny_fd_handle_t handle, uint32_t keep_alive)
 
 int tiny_fd_get_mtu(tiny_fd_handle_t handle)
 {
-    return tiny_fd_queue_get_mtu( &handle->frames.i_queue );
+    // I-frame slots have extra room for the 2nd byte of extended control field
+    return tiny_fd_queue_get_mtu( &handle->frames.i_queue ) - TINY_FD_EXT_CONTROL_SIZE;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1297,7 +2147,7 @@ int tiny_fd_send_to(tiny_fd_handle_t handle, uint8_t address, const void *data,
     int left = len;
     while ( left > 0 )
     {
-        int size = left < tiny_fd_queue_get_mtu( &handle->frames.i_queue ) ? left : tiny_fd_queue_get_mtu( &handle->frames.i_queue );
+        int size = left < tiny_fd_get_mtu( handle ) ? left : tiny_fd_get_mtu( handle );
         int result = tiny_fd_send_packet_to(handle, address, ptr, size);
         if ( result != TINY_SUCCESS )
         {
@@ -44,6 +44,7 @@ extern "C"
 
 #include <stdint.h>
 #include "proto/crc/tiny_crc.h"
+#include "proto/hdlc/low_level/hdlc.h"
 #include "hal/tiny_types.h"
 
     /**
@@ -78,6 +79,52 @@ extern "C"
         TINY_FD_MODE_ARM = 0x02,
     };
 
+    /**
+     * Value, which on_rx_frame_cb returns to keep the frame buffer until tiny_fd_release_rx() is called.
+     */
+    #define TINY_FD_RX_RETAIN (1)
+
+    /**
+     * on_rx_frame_cb is called every time new frame is received.
+     * @param udata user data
+     * @param address address of peer station
+     * @param pdata pointer to data received from the channel
+     * @param size size of received data
+     * @return TINY_FD_RX_RETAIN to keep the frame buffer, or 0 if frame buffer can be reused
+     *         right after return.
+     */
+    typedef int (*tiny_fd_rx_frame_cb_t)(void *udata, uint8_t address, uint8_t *pdata, int size);
+
+    #ifndef CONFIG_TINY_FD_RX_BATCH_SIZE
+    /**
+     * Maximum number of frames, passed to on_read_batch_cb at once. If on_read_batch_cb is used,
+     * the protocol needs CONFIG_TINY_FD_RX_BATCH_SIZE * sizeof(tiny_fd_rx_frame_t) bytes more
+     * in the buffer.
+     */
+    #define CONFIG_TINY_FD_RX_BATCH_SIZE 8
+    #endif
+
+    /**
+     * Frame, delivered to the application via on_read_batch_cb.
+     */
+    typedef struct
+    {
+        /// address of peer station
+        uint8_t address;
+        /// pointer to data received from the channel
+        uint8_t *data;
+        /// size of received data
+        int len;
+    } tiny_fd_rx_frame_t;
+
+    /**
+     * on_read_batch_cb is called with all frames, completed in single tiny_fd_on_rx_data() call.
+     * @param udata user data
+     * @param frames array of received frames
+     * @param count number of frames in the array
+     */
+    typedef void (*tiny_fd_rx_batch_cb_t)(void *udata, const tiny_fd_rx_frame_t *frames, int count);
+
     struct tiny_fd_data_t;
 
     /**
@@ -118,11 +165,16 @@ extern "C"
         /**
          * timeout for retry operation. It is valid and applicable to I-frames only.
          * retry_timeout sets timeout in milliseconds. If zero value is specified, it is calculated as
+         * send_timeout / (retries + 1). On the first timeout the remote side is polled with RR command,
+         * and only frames starting from N(R) of its response are retransmitted. If there is no response
+         * until the next timeout, all unconfirmed frames are retransmitted.
          */
         uint16_t retry_timeout;
 
         /**
-         * number retries to perform before timeout takes place
+         * number retries to perform before timeout takes place. The RR poll on the first timeout and
+         * each following retransmission of unconfirmed frames use up a retry, so the link is considered
+         * broken after retries + 1 timeouts.
          */
         uint8_t retries;
 
@@ -135,7 +187,9 @@ extern "C"
 
         /**
          * Number of frames in window, which confirmation may be deferred for. Must be at least 1. Maximum allowable
-         * value is 7. Extended HDLC format (with 127 window size) is not yet supported.
+         * value is 127. Values above 7 make the station request extended HDLC format (SABME/SNRME) with 2-byte
+         * control field and modulo 128 sequence numbers, which is negotiated for each link. If remote side
+         * establishes the link with modulo 8 numbers in NRM mode, the window is limited to 7 frames.
          * Smaller values reduce channel throughput, while higher values require more RAM.
          * It is not mandatory to have the same window_frames value on both endpoints.
          */
@@ -180,6 +234,98 @@ extern "C"
         /// Callback to get notification of sent frames. Callback is called from tiny_fd_run_tx() context.
         on_frame_send_cb_t on_send_cb;
 
+        /**
+         * Framing to use on hdlc level: HDLC_FRAMING_HDLC (default), HDLC_FRAMING_COBS or HDLC_FRAMING_LENGTH.
+         * COBS framing has bounded overhead for binary data full of 0x7E/0x7D bytes.
+         * Length prefixed framing avoids byte scanning at all, but is suitable for reliable byte streams only.
+         */
+        hdlc_framing_t framing;
+
+        /**
+         * If true, frames received without escape sequences in single tiny_fd_on_rx_data() call are
+         * processed in place, without copying to internal buffer. on_read_cb gets pointer to the
+         * buffer passed to tiny_fd_on_rx_data() in this case, so the data must not be modified.
+         */
+        bool zero_copy_rx;
+
+        /**
+         * If true, crc of I-frame payload is calculated once, when the frame is put to the queue.
+         * Every transmission and retransmission of the frame then calculates crc of 2-byte header
+         * only and combines it with the stored value. This saves CPU on noisy links with many
+         * retransmissions of large frames.
+         */
+        bool cache_crc;
+
+        /**
+         * Optional buffer for encode-ahead tx pipeline. If specified, the buffer is split into
+         * tx_pipe_blocks output blocks. tiny_fd_tx_encode() fills the blocks with encoded frames
+         * ahead of time, and I/O side drains them via tiny_fd_tx_acquire() / tiny_fd_tx_release().
+         * Leave NULL to use tiny_fd_get_tx_data() / tiny_fd_run_tx() only.
+         */
+        void *tx_pipe_buffer;
+
+        /// Size of tx_pipe_buffer in bytes
+        int tx_pipe_buffer_size;
+
+        /// Number of output blocks in tx pipeline, must be at least 2 if tx_pipe_buffer is specified
+        uint8_t tx_pipe_blocks;
+
+        /**
+         * Callback to process received frames, which can keep the frame buffer by returning
+         * TINY_FD_RX_RETAIN. Retaining frames requires rx_pool_buffer, otherwise return value is ignored.
+         * Callback is called from tiny_fd_on_rx_data() context.
+         */
+        tiny_fd_rx_frame_cb_t on_rx_frame_cb;
+
+        /**
+         * Optional buffer for pool of rx frame buffers. The buffer is split into rx_pool_frames
+         * frame buffers. While the application holds frames, retained via on_rx_frame_cb, the protocol
+         * decodes next frames into free buffers of the pool. If all buffers are retained,
+         * tiny_fd_on_rx_data() waits until some frame is released. zero_copy_rx is ignored if
+         * the pool is used.
+         */
+        void *rx_pool_buffer;
+
+        /// Size of rx_pool_buffer in bytes. Each frame buffer must fit mtu and frame overhead.
+        int rx_pool_buffer_size;
+
+        /// Number of frame buffers in rx pool, 1 - 31
+        uint8_t rx_pool_frames;
+
+        /**
+         * Callback to process all frames, completed in single tiny_fd_on_rx_data() call, at once.
+         * Single acknowledgement is sent for the whole batch. If specified, frames are not passed
+         * to other rx callbacks. Frames can be collected only if they stay valid until the end of
+         * tiny_fd_on_rx_data(): frames, decoded in place (zero_copy_rx), or to rx pool buffers.
+         * Otherwise the batch is delivered as soon as frame is received.
+         */
+        tiny_fd_rx_batch_cb_t on_read_batch_cb;
+
+        /**
+         * If true, out-of-order I-frames are held in free buffers of rx pool, and only the missing
+         * frame is requested from the remote side with selective reject (SREJ). Held frames are
+         * delivered in order once the gap is filled. Requires rx_pool_buffer. Window of the remote
+         * side must not exceed half of sequence numbers space: 4 frames, or 64 frames for the link
+         * with extended control field.
+         */
+        bool srej;
+
+        /**
+         * If true, corrupted or aborted frame, received while the remote side is sending I-frames,
+         * immediately causes REJ to be sent to the remote side. So lost I-frame is retransmitted after
+         * single round trip instead of retry_timeout. Only single peer links are covered, since address
+         * field of the broken frame cannot be trusted.
+         */
+        bool fast_nak;
+
+        /**
+         * Number of duplicate RR frames, after which unconfirmed I-frames are retransmitted at once,
+         * without waiting for retry_timeout. RR is duplicate if it confirms nothing, while sent frames
+         * are unconfirmed. Receiver with this option also answers every out-of-order I-frame after REJ
+         * with RR, so the loss is recovered quickly even if REJ is lost. 0 disables fast retransmit.
+         */
+        uint8_t fast_retransmit;
+
     } tiny_fd_init_t;
 
     /**
@@ -255,6 +401,61 @@ extern "C"
      */
     extern int tiny_fd_run_tx(tiny_fd_handle_t handle, write_block_cb_t write_func);
 
+    /**
+     * @brief encodes tx data ahead of time into next free block of tx pipeline.
+     *
+     * Runs tx processing to fill next free block of tx pipeline with encoded data. Call this
+     * function from encoder thread, while the I/O thread drains encoded blocks via
+     * tiny_fd_tx_acquire() and tiny_fd_tx_release(). Only one thread must call this function,
+     * and it must not be mixed with tiny_fd_get_tx_data() and tiny_fd_run_tx().
+     * on_sent_cb callback is called, when the frame is encoded, not when it is written to the channel.
+     *
+     * @param handle handle of full-duplex protocol
+     * @param timeout maximum time in milliseconds to wait for free block
+     * @return number of encoded bytes put to the pipeline, 0 if there is nothing to send
+     *         TINY_ERR_TIMEOUT if all blocks are occupied
+     *         TINY_ERR_FAILED if tx pipeline is not enabled
+     */
+    extern int tiny_fd_tx_encode(tiny_fd_handle_t handle, uint32_t timeout);
+
+    /**
+     * @brief returns next block of encoded tx data from tx pipeline.
+     *
+     * Returns next block of tx data, encoded by tiny_fd_tx_encode(). The block stays valid until
+     * tiny_fd_tx_release() is called. Calling the function again without tiny_fd_tx_release() returns
+     * the same block.
+     *
+     * @param handle handle of full-duplex protocol
+     * @param data pointer to store pointer to encoded data
+     * @param timeout maximum time in milliseconds to wait for encoded data
+     * @return number of bytes in the block
+     *         TINY_ERR_TIMEOUT if there is no encoded data
+     *         TINY_ERR_FAILED if tx pipeline is not enabled
+     */
+    extern int tiny_fd_tx_acquire(tiny_fd_handle_t handle, const void **data, uint32_t timeout);
+
+    /**
+     * @brief returns block, obtained via tiny_fd_tx_acquire(), back to tx pipeline.
+     *
+     * Marks the block as written to the channel, so tiny_fd_tx_encode() can reuse it.
+     *
+     * @param handle handle of full-duplex protocol
+     */
+    extern void tiny_fd_tx_release(tiny_fd_handle_t handle);
+
+    /**
+     * @brief returns frame, retained by on_rx_frame_cb, back to rx pool.
+     *
+     * Returns frame buffer, retained by on_rx_frame_cb callback, back to rx pool, so the protocol
+     * can decode new frames to it. The function can be called from any thread.
+     *
+     * @param handle handle of full-duplex protocol
+     * @param pdata pointer to the frame data, passed to on_rx_frame_cb
+     * @return TINY_SUCCESS if the frame is released
+     *         TINY_ERR_INVALID_DATA if the pointer is not retained frame
+     */
+    extern int tiny_fd_release_rx(tiny_fd_handle_t handle, uint8_t *pdata);
+
     /**
      * @brief runs rx bytes processing for specified buffer.
      *
@@ -267,6 +468,8 @@ extern "C"
      * @param data pointer to data to process
      * @param len length of data to process
      * @return TINY_SUCCESS
+     *         TINY_ERR_BUSY if all rx pool buffers are retained by the application for too long,
+     *         remaining data are dropped in this case.
      */
     extern int tiny_fd_on_rx_data(tiny_fd_handle_t handle, const void *data, int len);
 
@@ -315,6 +518,38 @@ extern "C"
      */
     extern int tiny_fd_send_packet_to(tiny_fd_handle_t handle, uint8_t address, const void *buf, int len);
 
+    /**
+     * @brief Reserves space for new I-frame in the protocol queue.
+     *
+     * The function allocates free slot in the internal queue and returns pointer to its payload area,
+     * so the user can serialize message directly to the protocol memory without extra copy.
+     * The frame is not sent until tiny_fd_commit_packet() is called. The reserved slot occupies
+     * the place in the window, so commit or cancel reservations as soon as possible.
+     *
+     * @param handle   tiny_fd_handle_t handle
+     * @param address  address of remote peer. For primary device, please use TINY_FD_PRIMARY_ADDR
+     * @param len      maximum length of data to put to reserved slot, must not exceed mtu
+     * @param timeout  maximum time in milliseconds to wait for free slot
+     *
+     * @return pointer to the payload area of len bytes or NULL if there is no free slot,
+     *         peer is not known, or len exceeds mtu.
+     */
+    extern void *tiny_fd_reserve_packet(tiny_fd_handle_t handle, uint8_t address, int len, uint32_t timeout);
+
+    /**
+     * @brief Puts I-frame, reserved via tiny_fd_reserve_packet(), to the send queue.
+     *
+     * Frames are sent in the order they are committed.
+     *
+     * @param handle   tiny_fd_handle_t handle
+     * @param data     pointer, returned by tiny_fd_reserve_packet()
+     * @param len      actual length of data, must not exceed reserved length. Pass 0 to cancel reservation.
+     *
+     * @return TINY_SUCCESS if the frame is put to send queue or reservation is cancelled.
+     *         TINY_ERR_INVALID_DATA if pointer is not reserved slot or length is too large.
+     */
+    extern int tiny_fd_commit_packet(tiny_fd_handle_t handle, void *data, int len);
+
     /**
      * Returns minimum required buffer size for specified parameters.
      *
@@ -55,8 +55,8 @@ int tiny_fd_queue_init(tiny_fd_queue_t *queue, uint8_t *buffer,
     for ( int i = 0; i < queue->size; i++ )
     {
         queue->frames[i] = (tiny_fd_frame_info_t *)ptr;
-        /* mtu must be correctly aligned also, so the developer must use only mtu multiple of 8 on 32-bit ARM systems */
-        ptr += mtu + sizeof(tiny_fd_frame_info_t) - sizeof(((tiny_fd_frame_info_t *)0)->payload);
+        /* Slot size is rounded up, so that frame info of the next slot is aligned for any mtu */
+        ptr += TINY_FD_QUEUE_SLOT_SIZE(mtu);
     }
     if ( ptr > buffer + max_size )
     {
@@ -73,6 +73,7 @@ void tiny_fd_queue_reset(tiny_fd_queue_t *queue)
     for (int i=0; i < queue->size; i++)
     {
         queue->frames[i]->type = TINY_FD_QUEUE_FREE;
+        queue->frames[i]->staged = 0;
     }
     queue->lookup_index = 0;
 }
@@ -81,9 +82,12 @@ void tiny_fd_queue_reset_for(tiny_fd_queue_t *queue, uint8_t address)
 {
     for (int i=0; i < queue->size; i++)
     {
-        if ( ( queue->frames[i]->header.address & 0xFC ) == (address & 0xFC) )
+        // Reserved slots belong to the user until they are committed
+        if ( queue->frames[i]->type != TINY_FD_QUEUE_RESERVED &&
+             ( queue->frames[i]->header.address & 0xFC ) == (address & 0xFC) )
         {
-            queue->frames[i]->type = TINY_FD_QUEUE_FREE;
+            // Staged slots are still read by hdlc level, they are released when hdlc level reports them
+            queue->frames[i]->type = queue->frames[i]->staged ? TINY_FD_QUEUE_PINNED : TINY_FD_QUEUE_FREE;
         }
     }
 }
@@ -93,9 +97,14 @@ tiny_fd_frame_info_t *tiny_fd_queue_allocate(tiny_fd_queue_t *queue, uint8_t typ
     tiny_fd_frame_info_t *ptr = len <= queue->mtu ?  tiny_fd_queue_get_next(queue, TINY_FD_QUEUE_FREE, 0, 0) : NULL;
     if ( ptr != NULL )
     {
-        memcpy( &ptr->payload[0], data, len );
+        if ( data != NULL )
+        {
+            memcpy( &ptr->payload[0], data, len );
+        }
         ptr->len = len;
         ptr->type = type;
+        ptr->ext_control = 0;
+        ptr->staged = 0;
     }
     return ptr;
 }
@@ -124,7 +133,8 @@ tiny_fd_frame_info_t *tiny_fd_queue_get_next(tiny_fd_queue_t *queue, uint8_t typ
                     break;
                 }
                 // Check for I-frame for the frame number
-                if ( ( ( queue->frames[index]->header.control >> 1 ) & 0x07 )  == arg )
+                uint8_t mask = queue->frames[index]->ext_control ? 0x7F : 0x07;
+                if ( ( ( queue->frames[index]->header.control >> 1 ) & mask )  == arg )
                 {
                     ptr = queue->frames[index];
                     break;
@@ -140,6 +150,30 @@ tiny_fd_frame_info_t *tiny_fd_queue_get_next(tiny_fd_queue_t *queue, uint8_t typ
     return ptr;
 }
 
+tiny_fd_frame_info_t *tiny_fd_queue_get_by_payload(tiny_fd_queue_t *queue, uint8_t type, const void *payload)
+{
+    for (int i=0; i < queue->size; i++)
+    {
+        if ( &queue->frames[i]->payload[queue->frames[i]->ext_control] == payload && queue->frames[i]->type == type )
+        {
+            return queue->frames[i];
+        }
+    }
+    return NULL;
+}
+
+tiny_fd_frame_info_t *tiny_fd_queue_get_by_header(tiny_fd_queue_t *queue, const void *header)
+{
+    for (int i=0; i < queue->size; i++)
+    {
+        if ( &queue->frames[i]->header == header )
+        {
+            return queue->frames[i];
+        }
+    }
+    return NULL;
+}
+
 void tiny_fd_queue_free(tiny_fd_queue_t *queue, tiny_fd_frame_info_t *frame)
 {
     tiny_fd_queue_free_by_header(queue, &frame->header);
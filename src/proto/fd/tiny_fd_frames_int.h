@@ -44,7 +44,9 @@ extern "C"
         TINY_FD_QUEUE_FREE = 0x01,
         TINY_FD_QUEUE_U_FRAME = 0x02,
         TINY_FD_QUEUE_S_FRAME = 0x04,
-        TINY_FD_QUEUE_I_FRAME = 0x08
+        TINY_FD_QUEUE_I_FRAME = 0x08,
+        TINY_FD_QUEUE_RESERVED = 0x10, ///< I-frame slot, being filled by the user
+        TINY_FD_QUEUE_PINNED = 0x20,   ///< Released I-frame slot, still staged to hdlc level
     } tiny_fd_queue_type_t;
 
     typedef struct
@@ -53,15 +55,26 @@ extern "C"
         uint8_t control;  // control field of HDLC protocol
     } tiny_frame_header_t;
 
+/// Extended (modulo 128) I- and S-frames have 2-byte control field, 2nd byte is kept in the payload area
+#define TINY_FD_EXT_CONTROL_SIZE 1
+
     typedef struct
     {
         uint8_t type; ///< tiny_fd_queue_type_t value
-        int len;      ///< payload of the frame
+        uint8_t ext_control; ///< 1 if payload[0] is 2nd byte of extended control field, user payload follows it
+        uint8_t staged; ///< 1 if frame is passed to hdlc level, and hdlc level has not reported it as sent yet
+        int len;      ///< size of user payload of the frame
+        uint32_t crc; ///< crc field value of user payload, if crc caching is enabled
         /* Aligning header to 1 byte, since header and user_payload together are the byte-stream */
         TINY_ALIGNED(1) tiny_frame_header_t header; ///< header, fill every time, when user payload is sending
         uint8_t payload[2];       ///< this byte and all bytes after are user payload
     } tiny_fd_frame_info_t;
 
+/// Size of queue slot for specified mtu, rounded up, so that every slot in the queue is aligned
+#define TINY_FD_QUEUE_SLOT_SIZE(mtu)                                                                         \
+    (((mtu) + sizeof(tiny_fd_frame_info_t) - sizeof(((tiny_fd_frame_info_t *)0)->payload) + TINY_ALIGN_STRUCT_VALUE - 1) & \
+     ~(TINY_ALIGN_STRUCT_VALUE - 1))
+
     typedef struct
     {
         tiny_fd_frame_info_t **frames;  ///< pointer to the frame table
@@ -105,7 +118,8 @@ extern "C"
     int tiny_fd_queue_get_mtu(tiny_fd_queue_t *queue);
 
     /**
-     * Allocates free slot in the queue and copies user data to the queue.
+     * Allocates free slot in the queue and copies user data to the queue. If data is NULL, nothing
+     * is copied, and the user fills the payload later.
      * If there are no space returns NULL, otherwise returns pointer to allocated frame info structure.
      */
     tiny_fd_frame_info_t *tiny_fd_queue_allocate(tiny_fd_queue_t *queue, uint8_t type, const uint8_t *data, int len);
@@ -116,11 +130,29 @@ extern "C"
      * @param queue pointer to queue structure
      * @param type type of the record to search for: tiny_fd_queue_type_t
      * @param arg arg used as the address field only for I-frame and must contain frame number to search for.
+     *        The frame number is 3-bit or 7-bit wide depending on the control field format of the frame.
      *
      * @important Remember that S-Frames and U-Frames can be reordered by the queue.
      */
     tiny_fd_frame_info_t *tiny_fd_queue_get_next(tiny_fd_queue_t *queue, uint8_t type, uint8_t address, uint8_t arg);
 
+    /**
+     * Returns frame of specified type, which user payload starts at specified address, or NULL.
+     *
+     * @param queue pointer to queue structure
+     * @param type type of the record to search for: tiny_fd_queue_type_t
+     * @param payload pointer to the payload of the frame
+     */
+    tiny_fd_frame_info_t *tiny_fd_queue_get_by_payload(tiny_fd_queue_t *queue, uint8_t type, const void *payload);
+
+    /**
+     * Returns frame, which header is located at specified address, or NULL.
+     *
+     * @param queue pointer to queue structure
+     * @param header pointer to the header of the frame
+     */
+    tiny_fd_frame_info_t *tiny_fd_queue_get_by_header(tiny_fd_queue_t *queue, const void *header);
+
     /**
      * Marks frame slot as free
      *
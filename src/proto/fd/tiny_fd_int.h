@@ -41,17 +41,18 @@ extern "C"
 #include "proto/hdlc/low_level/hdlc.h"
 #include "proto/hdlc/low_level/hdlc_int.h"
 #include "hal/tiny_types.h"
+#include "tiny_fd.h"
 #include "tiny_fd_frames_int.h"
 
 #define FD_PEER_BUF_SIZE() ( sizeof(tiny_fd_peer_info_t) )
 
 
 #define FD_MIN_BUF_SIZE(mtu, window) ( sizeof(tiny_fd_data_t) + TINY_ALIGN_STRUCT_VALUE - 1 + \
-                                      HDLC_MIN_BUF_SIZE( mtu + sizeof(tiny_frame_header_t), HDLC_CRC_16 ) + \
+                                      HDLC_MIN_BUF_SIZE( mtu + sizeof(tiny_frame_header_t) + TINY_FD_EXT_CONTROL_SIZE, HDLC_CRC_16 ) + \
                                       ( 1 * FD_PEER_BUF_SIZE() ) + \
-                                      ( sizeof(tiny_fd_frame_info_t *) + sizeof(tiny_fd_frame_info_t) + mtu \
-                                                                      - sizeof(((tiny_fd_frame_info_t *)0)->payload) ) * window + \
-                                      ( sizeof(tiny_fd_frame_info_t) + sizeof(tiny_fd_frame_info_t *) ) * TINY_FD_U_QUEUE_MAX_SIZE )
+                                      ( sizeof(tiny_fd_frame_info_t *) + TINY_FD_QUEUE_SLOT_SIZE( mtu + TINY_FD_EXT_CONTROL_SIZE ) ) * window + \
+                                      TINY_ALIGN_STRUCT_VALUE - 1 + \
+                                      ( TINY_FD_QUEUE_SLOT_SIZE(2) + sizeof(tiny_fd_frame_info_t *) ) * TINY_FD_U_QUEUE_MAX_SIZE )
 
     typedef enum
     {
@@ -80,11 +81,20 @@ extern "C"
         uint8_t next_ns;     // next frame to be sent
         uint8_t confirm_ns;  // next frame to be confirmed
         uint8_t last_ns;     // next free frame in cycle buffer
+        uint8_t reserved;    // number of I-frame slots, reserved by the user, but not committed yet
+        uint8_t extended;    // link uses extended control field with modulo 128 sequence numbers
+        uint8_t srej_pending; // selective reject is received, and srej_ns frame must be retransmitted
+        uint8_t srej_ns;     // frame requested by the remote side with selective reject
 
         uint32_t last_i_ts;  // last sent I-frame timestamp
         uint32_t last_ka_ts; // last keep alive timestamp
         uint8_t ka_confirmed;
         uint8_t retries;     // Number of retries to perform before timeout takes place
+        uint8_t ack_pending; // I-frames are delivered in rx batch, but not acknowledged yet
+        uint8_t rx_i_frames; // last valid frame from the peer is I-frame, so more I-frames may be on the way
+        uint8_t dup_rr;      // number of RRs in a row, which confirm no frames, while sent frames are unconfirmed
+        uint8_t checkpoint;  // RR command is queued on retry timeout, RR response with N(R) of the peer is awaited
+        uint8_t poll_sent;   // RR command is on the line, the first RR response after it answers the checkpoint
 
         tiny_events_t events;
 
@@ -101,6 +111,58 @@ extern "C"
 
     } tiny_frames_info_t;
 
+    typedef struct
+    {
+        /// Ring of output blocks, each block starts with the length of encoded data
+        uint8_t *buffer;
+        /// Size of single block including length field
+        int block_size;
+        /// Number of blocks in the ring, 0 if tx pipeline is not used
+        uint8_t blocks;
+        /// Next block to fill with encoded data
+        uint8_t head;
+        /// Next block to pass to I/O side
+        uint8_t tail;
+        /// Number of blocks with encoded data
+        uint8_t count;
+        /// Mutex to protect ring indexes
+        tiny_mutex_t mutex;
+    } tiny_fd_tx_pipe_t;
+
+    typedef struct
+    {
+        /// Frame buffers of the pool
+        uint8_t *buffer;
+        /// Size of single frame buffer
+        int frame_size;
+        /// Number of frame buffers, 0 if rx pool is not used
+        uint8_t frames;
+        /// Buffer hdlc level decodes frames to: 0 - hdlc own buffer, 1 and above - pool buffers
+        uint8_t current;
+        /// Set if all buffers are retained and hdlc level has nowhere to decode frames
+        uint8_t exhausted;
+        /// Bit mask of retained buffers
+        uint32_t retained;
+        /// Bit mask of buffers, holding out-of-order I-frames until the gap is filled
+        uint32_t held;
+        /// Lengths of held frames, allocated only if selective reject is enabled
+        uint16_t *held_len;
+        /// hdlc own rx buffer
+        void *hdlc_buf;
+        /// Size of hdlc own rx buffer
+        int hdlc_buf_size;
+    } tiny_fd_rx_pool_t;
+
+    typedef struct
+    {
+        /// Frames waiting for delivery, allocated only if on_read_batch_cb is used
+        tiny_fd_rx_frame_t *frames;
+        /// Number of frames waiting for delivery
+        uint8_t count;
+        /// Bit mask of rx pool buffers, held by the batch
+        uint32_t pool_mask;
+    } tiny_fd_rx_batch_t;
+
     typedef struct tiny_fd_data_t
     {
         /// Callback to process received frames
@@ -111,6 +173,10 @@ extern "C"
         on_frame_read_cb_t on_read_cb;
         /// Callback to process received frames
         on_frame_send_cb_t on_send_cb;
+        /// Callback to process received frames with option to keep frame buffer
+        tiny_fd_rx_frame_cb_t on_rx_frame_cb;
+        /// Callback to process batch of received frames
+        tiny_fd_rx_batch_cb_t on_read_batch_cb;
         /// Callback to get connect/disconnect notification
         on_connect_event_cb_t on_connect_event_cb;
         /// hdlc information
@@ -137,6 +203,22 @@ extern "C"
         uint32_t last_marker_ts;
         /// HDLC mode;
         uint8_t mode;
+        /// Keep crc of I-frame payloads to avoid crc calculation on retransmissions
+        uint8_t cache_crc;
+        /// Selective reject is enabled for received frames
+        uint8_t srej;
+        /// Send REJ as soon as corrupted frame is received
+        uint8_t fast_nak;
+        /// Number of duplicate RRs, which triggers retransmission, 0 if disabled
+        uint8_t fast_retransmit;
+        /// Unconfirmed frames are rewound, and I-frames queued to hdlc level must be dropped
+        uint8_t tx_flush;
+        /// Encode-ahead tx pipeline
+        tiny_fd_tx_pipe_t tx_pipe;
+        /// Pool of rx frame buffers
+        tiny_fd_rx_pool_t rx_pool;
+        /// Received frames waiting for delivery via on_read_batch_cb
+        tiny_fd_rx_batch_t rx_batch;
         /// Global events for HDLC protocol
         tiny_events_t events;
         /// user specific data
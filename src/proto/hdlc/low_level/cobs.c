@@ -0,0 +1,248 @@
+/*
+    Copyright 2022 (C) Alexey Dynda
+
+    This file is part of Tiny Protocol Library.
+
+    GNU General Public License Usage
+
+    Protocol Library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Protocol Library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Protocol Library.  If not, see <http://www.gnu.org/licenses/>.
+
+    Commercial License Usage
+
+    Licensees holding valid commercial Tiny Protocol licenses may use this file in
+    accordance with the commercial license agreement provided in accordance with
+    the terms contained in a written agreement between you and Alexey Dynda.
+    For further information contact via email on github account.
+*/
+
+/*
+ * Consistent Overhead Byte Stuffing framing for hdlc low level.
+ *
+ *   8       8       any len            8
+ * | 00 | CODE | DATA ... CODE | DATA | 00 |
+ *
+ * Frame body (user data followed by crc field) is split into blocks ending with 0x00 byte.
+ * Each block is sent as CODE byte, equal to block length + 1, followed by the block without
+ * trailing zero. Blocks of 254 non-zero bytes have CODE 0xFF and no trailing zero. The zero
+ * after the last block is implied. Thus 0x00 never appears inside the frame, and the overhead
+ * is at most 1 byte per 254 bytes of the frame body.
+ */
+
+#include "hdlc.h"
+#include "hdlc_int.h"
+#include "proto/crc/tiny_crc.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define COBS_DELIMITER 0x00
+#define COBS_MAX_BLOCK 254
+
+static int cobs_ll_read_data(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+
+static int cobs_ll_send_begin(hdlc_ll_handle_t handle);
+static int cobs_ll_send_code(hdlc_ll_handle_t handle);
+static int cobs_ll_send_block(hdlc_ll_handle_t handle);
+
+const hdlc_ll_framing_t hdlc_ll_framing_cobs = {
+    .delimiter = COBS_DELIMITER,
+    .max_len = 0,
+    .read_start = hdlc_ll_read_start,
+    .read_data = cobs_ll_read_data,
+    .send_start = hdlc_ll_send_start,
+    .send_data = cobs_ll_send_begin,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/* Returns crc field byte, which is index bytes ahead of the next crc byte to send */
+static uint8_t cobs_ll_tail_byte(hdlc_ll_handle_t handle, int index)
+{
+    int pos = get_crc_field_size(handle->crc_type) - handle->tx.tail + index;
+    return (uint8_t)(handle->tx.crc >> (pos * 8));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int cobs_ll_send_begin(hdlc_ll_handle_t handle)
+{
+    // Code byte must know the position of the next zero byte, including crc field,
+    // so crc is calculated before encoding the frame
+    handle->tx.crc = hdlc_ll_crc_frame(handle);
+    handle->tx.tail = get_crc_field_size(handle->crc_type);
+    handle->tx.state = cobs_ll_send_code;
+    return cobs_ll_send_code(handle);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/* Returns number of non-zero bytes up to the next zero byte, looking through frame segments and crc field */
+static int cobs_ll_block_size(hdlc_ll_handle_t handle)
+{
+    const uint8_t *data = handle->tx.data;
+    int len = handle->tx.len;
+    int run = 0;
+    for ( int seg = 0;; seg++ )
+    {
+        int limit = len < COBS_MAX_BLOCK - run ? len : COBS_MAX_BLOCK - run;
+        const uint8_t *zero = limit ? (const uint8_t *)memchr(data, COBS_DELIMITER, limit) : NULL;
+        if ( zero )
+        {
+            return run + (int)(zero - data);
+        }
+        run += limit;
+        if ( run == COBS_MAX_BLOCK || seg == handle->tx.segs_left )
+        {
+            break;
+        }
+        data = (const uint8_t *)handle->tx.segs[seg].data;
+        len = handle->tx.segs[seg].len;
+    }
+    // Block continues to crc field
+    for ( int i = 0; run < COBS_MAX_BLOCK && i < handle->tx.tail && cobs_ll_tail_byte(handle, i); i++ )
+    {
+        run++;
+    }
+    return run;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int cobs_ll_send_code(hdlc_ll_handle_t handle)
+{
+    int run = cobs_ll_block_size(handle);
+    uint8_t code = (uint8_t)(run + 1);
+    int result = hdlc_ll_send_tx_internal(handle, &code, sizeof(code));
+    if ( result == 1 )
+    {
+        handle->tx.run = (uint8_t)run;
+        // tx.escape marks block ending with zero byte (or implied zero at the end of the frame)
+        handle->tx.escape = run < COBS_MAX_BLOCK;
+        handle->tx.state = cobs_ll_send_block;
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int cobs_ll_send_block(hdlc_ll_handle_t handle)
+{
+    int result = 0;
+    if ( handle->tx.run )
+    {
+        if ( handle->tx.len )
+        {
+            result = hdlc_ll_send_tx_internal(handle, handle->tx.data,
+                                              handle->tx.run < handle->tx.len ? handle->tx.run : handle->tx.len);
+            handle->tx.data += result;
+            handle->tx.len -= result;
+            if ( !handle->tx.len )
+            {
+                hdlc_ll_next_segment(handle);
+            }
+        }
+        else
+        {
+            uint8_t byte = cobs_ll_tail_byte(handle, 0);
+            result = hdlc_ll_send_tx_internal(handle, &byte, sizeof(byte));
+            handle->tx.tail -= result;
+        }
+        handle->tx.run -= result;
+    }
+    if ( !handle->tx.run )
+    {
+        if ( !handle->tx.len && !handle->tx.tail )
+        {
+            handle->tx.state = hdlc_ll_send_end;
+        }
+        else
+        {
+            if ( handle->tx.escape )
+            {
+                // Skip zero byte, it is replaced by the code byte
+                if ( handle->tx.len )
+                {
+                    handle->tx.data++;
+                    handle->tx.len--;
+                    if ( !handle->tx.len )
+                    {
+                        hdlc_ll_next_segment(handle);
+                    }
+                }
+                else
+                {
+                    handle->tx.tail--;
+                }
+            }
+            handle->tx.state = cobs_ll_send_code;
+        }
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int cobs_ll_read_data(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+{
+    int result = 0;
+    uint8_t *start = handle->rx.data;
+    uint8_t *end = (uint8_t *)handle->rx_buf + handle->rx_buf_size;
+    while ( len > 0 )
+    {
+        int run = 1;
+        if ( data[0] == COBS_DELIMITER )
+        {
+            result++;
+            if ( handle->rx.data == handle->rx_buf && !handle->rx.escape && !handle->rx.run )
+            {
+                // Back to back delimiters, nothing to decode
+                data++;
+                len--;
+                continue;
+            }
+            handle->rx.state = hdlc_ll_read_end;
+            break;
+        }
+        if ( !handle->rx.run )
+        {
+            // Code byte. Zero byte, ending previous block, is added only now, since the zero
+            // after the last block of the frame is implied
+            if ( handle->rx.escape && handle->rx.data < end )
+            {
+                *handle->rx.data++ = 0;
+            }
+            handle->rx.run = data[0] - 1;
+            handle->rx.escape = data[0] != COBS_MAX_BLOCK + 1;
+        }
+        else
+        {
+            // Copy block at once, bytes not fitting rx buffer are dropped
+            run = handle->rx.run < len ? handle->rx.run : len;
+            const uint8_t *zero = (const uint8_t *)memchr(data, COBS_DELIMITER, run);
+            if ( zero )
+            {
+                run = (int)(zero - data);
+            }
+            int room = (int)(end - handle->rx.data);
+            memcpy(handle->rx.data, data, run < room ? run : room);
+            handle->rx.data += run < room ? run : room;
+            handle->rx.run -= run;
+        }
+        result += run;
+        data += run;
+        len -= run;
+    }
+    handle->rx.crc = hdlc_ll_crc_update(handle->crc_type, handle->rx.crc, start, (int)(handle->rx.data - start));
+    return result;
+}
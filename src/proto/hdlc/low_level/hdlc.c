@@ -32,6 +32,15 @@
 #include "hal/tiny_debug.h"
 
 #include <stddef.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#define HDLC_SIMD_X86 1
+#elif defined(__GNUC__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HDLC_SIMD_NEON 1
+#endif
 
 #ifndef TINY_HDLC_DEBUG
 #define TINY_HDLC_DEBUG 0
@@ -43,6 +52,12 @@
 #define LOG(...)
 #endif
 
+#ifdef CONFIG_ENABLE_STATS
+#define STATS(x) x
+#else
+#define STATS(x)
+#endif
+
 #define FLAG_SEQUENCE 0x7E
 #define FILL_BYTE 0xFF
 #define TINY_ESCAPE_CHAR 0x7D
@@ -56,15 +71,208 @@ enum
     RX_DATA_READY_BIT = 0x08,
 };
 
-static int hdlc_ll_read_start(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+static void hdlc_ll_read_restart(hdlc_ll_handle_t handle);
 static int hdlc_ll_read_data(hdlc_ll_handle_t handle, const uint8_t *data, int len);
-static int hdlc_ll_read_end(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+static int hdlc_ll_read_data_table(hdlc_ll_handle_t handle, const uint8_t *data, int len);
 
-static int hdlc_ll_send_start(hdlc_ll_handle_t handle);
 static int hdlc_ll_send_data(hdlc_ll_handle_t handle);
-static int hdlc_ll_send_tx_internal(hdlc_ll_handle_t handle, const void *data, int len);
 static int hdlc_ll_send_crc(hdlc_ll_handle_t handle);
-static int hdlc_ll_send_end(hdlc_ll_handle_t handle);
+
+static const hdlc_ll_framing_t hdlc_ll_framing_hdlc = {
+    .delimiter = FLAG_SEQUENCE,
+    .max_len = 0,
+    .read_start = hdlc_ll_read_start,
+    .read_data = hdlc_ll_read_data,
+    .send_start = hdlc_ll_send_start,
+    .send_data = hdlc_ll_send_data,
+};
+
+/* The same HDLC framing, decoded by table driven state machine */
+static const hdlc_ll_framing_t hdlc_ll_framing_hdlc_table = {
+    .delimiter = FLAG_SEQUENCE,
+    .max_len = 0,
+    .read_start = hdlc_ll_read_start,
+    .read_data = hdlc_ll_read_data_table,
+    .send_start = hdlc_ll_send_start,
+    .send_data = hdlc_ll_send_data,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Crc is calculated on the fly: TX updates the running register with every block of
+ * payload bytes being sent, RX updates it with every block of unescaped bytes written
+ * to rx buffer, including received crc field. So, the frame is verified by checking
+ * the residue, once the closing flag arrives.
+ */
+
+crc_t hdlc_ll_crc_init(hdlc_crc_t crc_type)
+{
+    switch ( crc_type )
+    {
+#ifdef CONFIG_ENABLE_FCS16
+        case HDLC_CRC_16: return PPPINITFCS16;
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        case HDLC_CRC_32: return PPPINITFCS32;
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        case HDLC_CRC_32C: return PPPINITFCS32C;
+#endif
+#ifdef CONFIG_ENABLE_CHECKSUM
+        case HDLC_CRC_8: return INITCHECKSUM;
+#endif
+        default: return 0;
+    }
+}
+
+crc_t hdlc_ll_crc_update(hdlc_crc_t crc_type, crc_t crc, const uint8_t *data, int len)
+{
+    switch ( crc_type )
+    {
+#ifdef CONFIG_ENABLE_FCS16
+        case HDLC_CRC_16: return crc16_update(crc, data, len);
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        case HDLC_CRC_32: return crc32_update(crc, data, len);
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        case HDLC_CRC_32C: return crc32c_update(crc, data, len);
+#endif
+#ifdef CONFIG_ENABLE_CHECKSUM
+        case HDLC_CRC_8: return chksum_update(crc, data, len);
+#endif
+        default: return crc;
+    }
+}
+
+crc_t hdlc_ll_crc_final(hdlc_crc_t crc_type, crc_t crc)
+{
+    switch ( crc_type )
+    {
+#ifdef CONFIG_ENABLE_FCS16
+        case HDLC_CRC_16: return (uint16_t)(crc ^ 0xFFFF);
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        case HDLC_CRC_32: return crc ^ 0xFFFFFFFF;
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        case HDLC_CRC_32C: return crc ^ 0xFFFFFFFF;
+#endif
+#ifdef CONFIG_ENABLE_CHECKSUM
+        case HDLC_CRC_8: return (uint16_t)(0xFFFF - crc);
+#endif
+        default: return crc;
+    }
+}
+
+uint32_t hdlc_ll_crc(hdlc_crc_t crc_type, const void *data, int len)
+{
+    crc_type = crc_type == HDLC_CRC_OFF ? 0 : crc_type;
+    return hdlc_ll_crc_final(crc_type,
+                             hdlc_ll_crc_update(crc_type, hdlc_ll_crc_init(crc_type), (const uint8_t *)data, len));
+}
+
+uint32_t hdlc_ll_crc_combine(hdlc_crc_t crc_type, uint32_t crc1, uint32_t crc2, int len2)
+{
+    switch ( crc_type )
+    {
+#ifdef CONFIG_ENABLE_FCS16
+        case HDLC_CRC_16: return crc16_combine((uint16_t)crc1, (uint16_t)crc2, len2);
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        case HDLC_CRC_32: return crc32_combine(crc1, crc2, len2);
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        case HDLC_CRC_32C: return crc32c_combine(crc1, crc2, len2);
+#endif
+#ifdef CONFIG_ENABLE_CHECKSUM
+        // Sums are just added
+        case HDLC_CRC_8: return (uint16_t)(0xFFFF - ((0xFFFF - crc1) + (0xFFFF - crc2)));
+#endif
+        default: return 0;
+    }
+}
+
+static bool hdlc_ll_crc_is_good(hdlc_crc_t crc_type, crc_t crc)
+{
+    switch ( crc_type )
+    {
+#ifdef CONFIG_ENABLE_FCS16
+        case HDLC_CRC_16: return crc == PPPGOODFCS16;
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        case HDLC_CRC_32: return crc == PPPGOODFCS32;
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        case HDLC_CRC_32C: return crc == PPPGOODFCS32C;
+#endif
+#ifdef CONFIG_ENABLE_CHECKSUM
+        // Only low byte of inverted sum is transmitted, so data and checksum byte give 0xFF
+        case HDLC_CRC_8: return (crc & 0xFF) == 0xFF;
+#endif
+        default: return true;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+ * Returns position of the first FLAG_SEQUENCE or TINY_ESCAPE_CHAR byte in the block,
+ * or len if there are no special bytes. SIMD extensions available at compile time
+ * are used to check 16-32 bytes at once.
+ */
+static int hdlc_ll_find_special(const uint8_t *data, int len)
+{
+    int pos = 0;
+#if defined(HDLC_SIMD_X86) && defined(__AVX2__)
+    const __m256i flag32 = _mm256_set1_epi8((char)FLAG_SEQUENCE);
+    const __m256i escape32 = _mm256_set1_epi8((char)TINY_ESCAPE_CHAR);
+    for ( ; pos + 32 <= len; pos += 32 )
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + pos));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, flag32), _mm256_cmpeq_epi8(block, escape32)));
+        if ( mask )
+        {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+#endif
+#if defined(HDLC_SIMD_X86)
+    const __m128i flag16 = _mm_set1_epi8((char)FLAG_SEQUENCE);
+    const __m128i escape16 = _mm_set1_epi8((char)TINY_ESCAPE_CHAR);
+    for ( ; pos + 16 <= len; pos += 16 )
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + pos));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, flag16), _mm_cmpeq_epi8(block, escape16)));
+        if ( mask )
+        {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+#elif defined(HDLC_SIMD_NEON)
+    const uint8x16_t flag16 = vdupq_n_u8(FLAG_SEQUENCE);
+    const uint8x16_t escape16 = vdupq_n_u8(TINY_ESCAPE_CHAR);
+    for ( ; pos + 16 <= len; pos += 16 )
+    {
+        uint8x16_t block = vld1q_u8(data + pos);
+        uint8x16_t eq = vorrq_u8(vceqq_u8(block, flag16), vceqq_u8(block, escape16));
+        // Narrow 16 x 8-bit compare results to 16 x 4-bit mask
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if ( mask )
+        {
+            return pos + (__builtin_ctzll(mask) >> 2);
+        }
+    }
+#endif
+    while ( pos < len && data[pos] != FLAG_SEQUENCE && data[pos] != TINY_ESCAPE_CHAR )
+    {
+        pos++;
+    }
+    return pos;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -87,6 +295,19 @@ int hdlc_ll_init(hdlc_ll_handle_t *handle, hdlc_ll_init_t *init)
     (*handle)->on_frame_read = init->on_frame_read;
     (*handle)->on_frame_sent = init->on_frame_sent;
     (*handle)->user_data = init->user_data;
+    (*handle)->rx.zero_copy = init->zero_copy_rx;
+    (*handle)->rx.min_len = (init->min_frame_len ? init->min_frame_len : 1) + (uint8_t)(*handle)->crc_type / 8;
+    switch ( init->framing )
+    {
+        case HDLC_FRAMING_COBS: (*handle)->framing = &hdlc_ll_framing_cobs; break;
+        case HDLC_FRAMING_LENGTH: (*handle)->framing = &hdlc_ll_framing_length; break;
+        default:
+            (*handle)->framing = init->table_decoder ? &hdlc_ll_framing_hdlc_table : &hdlc_ll_framing_hdlc;
+            break;
+    }
+#ifdef CONFIG_ENABLE_STATS
+    memset(&(*handle)->stats, 0, sizeof((*handle)->stats));
+#endif
 
     // Must be last
     hdlc_ll_reset(*handle, HDLC_LL_RESET_BOTH);
@@ -95,39 +316,72 @@ int hdlc_ll_init(hdlc_ll_handle_t *handle, hdlc_ll_init_t *init)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+static int hdlc_ll_frame_len(int len, const hdlc_ll_iov_t *segs, uint8_t segs_left)
+{
+    for ( uint8_t i = 0; i < segs_left; i++ )
+    {
+        len += segs[i].len;
+    }
+    return len;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 int hdlc_ll_close(hdlc_ll_handle_t handle)
 {
     if ( handle && handle->tx.data )
     {
         if ( handle->on_frame_sent )
         {
-            handle->on_frame_sent(handle->user_data, handle->tx.origin_data,
-                                  (int)(handle->tx.data - handle->tx.origin_data) + handle->tx.len);
+            handle->on_frame_sent(handle->user_data, handle->tx.origin_data, handle->tx.frame_len);
         }
+        // Return queued frames to the user too, so that their buffers can be released
+        hdlc_ll_flush(handle);
     }
     return TINY_SUCCESS;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void hdlc_ll_flush(hdlc_ll_handle_t handle)
+{
+    while ( handle->tx.queue_len )
+    {
+        uint8_t index = handle->tx.queue_head;
+        handle->tx.queue_head = (uint8_t)((index + 1) % CONFIG_HDLC_LL_TX_QUEUE_SIZE);
+        handle->tx.queue_len--;
+        if ( handle->on_frame_sent )
+        {
+            handle->on_frame_sent(handle->user_data, handle->tx.queue[index].data,
+                                  hdlc_ll_frame_len(handle->tx.queue[index].len, handle->tx.queue[index].segs,
+                                                    handle->tx.queue[index].segs_left));
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void hdlc_ll_reset(hdlc_ll_handle_t handle, uint8_t flags)
 {
     if ( flags != HDLC_LL_RESET_TX_ONLY )
     {
-        handle->rx.state = hdlc_ll_read_start;
+        hdlc_ll_read_restart(handle);
+        handle->rx.state = handle->framing->read_start;
     }
     if ( flags != HDLC_LL_RESET_RX_ONLY )
     {
         handle->tx.data = NULL;
         handle->tx.origin_data = NULL;
         handle->tx.escape = 0;
-        handle->tx.state = hdlc_ll_send_start;
+        handle->tx.queue_head = 0;
+        handle->tx.queue_len = 0;
+        handle->tx.state = handle->framing->send_start;
     }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////
 
-static int hdlc_ll_send_start(hdlc_ll_handle_t handle)
+int hdlc_ll_send_start(hdlc_ll_handle_t handle)
 {
     // Do not clear data ready bit here in case if 0x7F is failed to be sent
     if ( !handle->tx.origin_data )
@@ -136,28 +390,18 @@ static int hdlc_ll_send_start(hdlc_ll_handle_t handle)
         return 0;
     }
     LOG(TINY_LOG_INFO, "[HDLC:%p] Starting send op for HDLC frame\n", handle);
-    switch ( handle->crc_type )
-    {
-#ifdef CONFIG_ENABLE_FCS16
-        case HDLC_CRC_16: handle->tx.crc = tiny_crc16(PPPINITFCS16, handle->tx.data, handle->tx.len); break;
-#endif
-#ifdef CONFIG_ENABLE_FCS32
-        case HDLC_CRC_32: handle->tx.crc = tiny_crc32(PPPINITFCS32, handle->tx.data, handle->tx.len); break;
-#endif
-#ifdef CONFIG_ENABLE_CHECKSUM
-        case HDLC_CRC_8: handle->tx.crc = tiny_chksum(INITCHECKSUM, handle->tx.data, handle->tx.len); break;
-#endif
-        default: break;
-    }
-
-    uint8_t buf[1] = {FLAG_SEQUENCE};
+    uint8_t buf[1] = {handle->framing->delimiter};
     int result = hdlc_ll_send_tx_internal(handle, buf, sizeof(buf));
     if ( result == 1 )
     {
         LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_send_data\n", handle);
         LOG(TINY_LOG_DEB, "[HDLC:%p] TX: %02X\n", handle, buf[0]);
-        handle->tx.state = hdlc_ll_send_data;
+        handle->tx.state = handle->framing->send_data;
         handle->tx.escape = 0;
+        if ( !handle->tx.crc_known )
+        {
+            handle->tx.crc = hdlc_ll_crc_init(handle->crc_type);
+        }
     }
     return result;
 }
@@ -173,11 +417,9 @@ static int hdlc_ll_send_data(hdlc_ll_handle_t handle)
     //    handle->tx.state = hdlc_ll_send_crc;
     //    return 0;
     //}
-    int pos = 0;
-    while ( handle->tx.data[pos] != FLAG_SEQUENCE && handle->tx.data[pos] != TINY_ESCAPE_CHAR && pos < handle->tx.len )
-    {
-        pos++;
-    }
+    // There is no sense to scan more bytes, than output buffer can accept
+    int pos = hdlc_ll_find_special(handle->tx.data, handle->tx.len < handle->tx.out_buffer_len ? handle->tx.len
+                                                                                                : handle->tx.out_buffer_len);
     int result = 0;
     if ( pos )
     {
@@ -188,6 +430,10 @@ static int hdlc_ll_send_data(hdlc_ll_handle_t handle)
             for ( int i = 0; i < result; i++ )
                 LOG(TINY_LOG_DEB, "[HDLC:%p] TX: %02X\n", handle, handle->tx.data[i]);
 #endif
+            if ( !handle->tx.crc_known )
+            {
+                handle->tx.crc = hdlc_ll_crc_update(handle->crc_type, handle->tx.crc, handle->tx.data, result);
+            }
             handle->tx.data += result;
             handle->tx.len -= result;
         }
@@ -202,14 +448,22 @@ static int hdlc_ll_send_data(hdlc_ll_handle_t handle)
             handle->tx.escape = !handle->tx.escape;
             if ( !handle->tx.escape )
             {
+                if ( !handle->tx.crc_known )
+                {
+                    handle->tx.crc = hdlc_ll_crc_update(handle->crc_type, handle->tx.crc, handle->tx.data, 1);
+                }
                 handle->tx.data++;
                 handle->tx.len--;
             }
         }
     }
-    if ( handle->tx.len == 0 )
+    if ( handle->tx.len == 0 && !hdlc_ll_next_segment(handle) )
     {
         LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_send_crc\n", handle);
+        if ( !handle->tx.crc_known )
+        {
+            handle->tx.crc = hdlc_ll_crc_final(handle->crc_type, handle->tx.crc);
+        }
         handle->tx.state = hdlc_ll_send_crc;
     }
     return result;
@@ -220,7 +474,8 @@ static int hdlc_ll_send_data(hdlc_ll_handle_t handle)
 static int hdlc_ll_send_crc(hdlc_ll_handle_t handle)
 {
     int result = 1;
-    if ( handle->tx.len == (uint8_t)handle->crc_type )
+    // tx.len counts sent crc bits here
+    if ( handle->tx.len == get_crc_field_size(handle->crc_type) * 8 )
     {
         handle->tx.state = hdlc_ll_send_end;
     }
@@ -256,24 +511,24 @@ static int hdlc_ll_send_crc(hdlc_ll_handle_t handle)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-static int hdlc_ll_send_end(hdlc_ll_handle_t handle)
+int hdlc_ll_send_end(hdlc_ll_handle_t handle)
 {
     LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_send_end\n", handle);
-    uint8_t buf[1] = {FLAG_SEQUENCE};
+    uint8_t buf[1] = {handle->framing->delimiter};
     int result = hdlc_ll_send_tx_internal(handle, buf, sizeof(buf));
     if ( result == 1 )
     {
         LOG(TINY_LOG_DEB, "[HDLC:%p] TX: %02X\n", handle, buf[0]);
         LOG(TINY_LOG_INFO, "[HDLC:%p] hdlc_ll_send_end HDLC send op successful\n", handle);
-        handle->tx.state = hdlc_ll_send_start;
-        handle->tx.escape = 0;
-        int len = (int)(handle->tx.data - handle->tx.origin_data);
-        const void *ptr = handle->tx.origin_data;
-        handle->tx.origin_data = NULL;
-        handle->tx.data = NULL;
-        if ( handle->on_frame_sent )
+        // If next frame is already available (queued or put from the callback), then the flag just sent
+        // is also the opening flag of the next frame (RFC 1662)
+        if ( hdlc_ll_send_complete(handle) )
         {
-            handle->on_frame_sent(handle->user_data, ptr, len);
+            handle->tx.state = handle->framing->send_data;
+            if ( !handle->tx.crc_known )
+            {
+                handle->tx.crc = hdlc_ll_crc_init(handle->crc_type);
+            }
         }
     }
     return result;
@@ -281,18 +536,80 @@ static int hdlc_ll_send_end(hdlc_ll_handle_t handle)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-static int hdlc_ll_send_tx_internal(hdlc_ll_handle_t handle, const void *data, int len)
+bool hdlc_ll_send_complete(hdlc_ll_handle_t handle)
+{
+    handle->tx.state = handle->framing->send_start;
+    handle->tx.escape = 0;
+    int len = handle->tx.frame_len;
+    const void *ptr = handle->tx.origin_data;
+    handle->tx.origin_data = NULL;
+    handle->tx.data = NULL;
+    if ( handle->tx.queue_len )
+    {
+        uint8_t index = handle->tx.queue_head;
+        handle->tx.queue_head = (uint8_t)((index + 1) % CONFIG_HDLC_LL_TX_QUEUE_SIZE);
+        handle->tx.queue_len--;
+        handle->tx.origin_data = handle->tx.queue[index].data;
+        handle->tx.data = handle->tx.queue[index].data;
+        handle->tx.len = handle->tx.queue[index].len;
+        handle->tx.segs = handle->tx.queue[index].segs;
+        handle->tx.segs_left = handle->tx.queue[index].segs_left;
+        handle->tx.crc = handle->tx.queue[index].crc;
+        handle->tx.crc_known = handle->tx.queue[index].crc_known;
+        handle->tx.frame_len = hdlc_ll_frame_len(handle->tx.queue[index].len, handle->tx.queue[index].segs,
+                                                 handle->tx.queue[index].segs_left);
+    }
+    if ( handle->on_frame_sent )
+    {
+        handle->on_frame_sent(handle->user_data, ptr, len);
+    }
+    return handle->tx.origin_data != NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool hdlc_ll_next_segment(hdlc_ll_handle_t handle)
+{
+    while ( handle->tx.segs_left )
+    {
+        handle->tx.data = (const uint8_t *)handle->tx.segs->data;
+        handle->tx.len = handle->tx.segs->len;
+        handle->tx.segs++;
+        handle->tx.segs_left--;
+        if ( handle->tx.len )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+crc_t hdlc_ll_crc_frame(hdlc_ll_handle_t handle)
 {
-    const uint8_t *ptr = (const uint8_t *)data;
-    int sent = 0;
-    while ( len-- && handle->tx.out_buffer_len )
+    if ( handle->tx.crc_known )
+    {
+        return handle->tx.crc;
+    }
+    crc_t crc = hdlc_ll_crc_update(handle->crc_type, hdlc_ll_crc_init(handle->crc_type), handle->tx.data,
+                                   handle->tx.len);
+    for ( int i = 0; i < handle->tx.segs_left; i++ )
     {
-        handle->tx.out_buffer[0] = ptr[0];
-        handle->tx.out_buffer_len--;
-        handle->tx.out_buffer++;
-        ptr++;
-        sent++;
+        crc = hdlc_ll_crc_update(handle->crc_type, crc, (const uint8_t *)handle->tx.segs[i].data,
+                                 handle->tx.segs[i].len);
     }
+    return hdlc_ll_crc_final(handle->crc_type, crc);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_send_tx_internal(hdlc_ll_handle_t handle, const void *data, int len)
+{
+    int sent = len < handle->tx.out_buffer_len ? len : handle->tx.out_buffer_len;
+    memcpy(handle->tx.out_buffer, data, sent);
+    handle->tx.out_buffer_len -= sent;
+    handle->tx.out_buffer += sent;
     return sent;
 }
 
@@ -341,47 +658,132 @@ int hdlc_ll_run_tx(hdlc_ll_handle_t handle, void *data, int len)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-int hdlc_ll_put(hdlc_ll_handle_t handle, const void *data, int len)
+static int hdlc_ll_put_frame(hdlc_ll_handle_t handle, const void *data, int len, const hdlc_ll_iov_t *segs,
+                             uint8_t segs_left, int frame_len, const crc_t *crc)
 {
-    LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_put\n", handle);
-    if ( !len || !data || !handle )
+    if ( handle->framing->max_len && frame_len + get_crc_field_size(handle->crc_type) > handle->framing->max_len )
     {
-        return TINY_ERR_INVALID_DATA;
+        return TINY_ERR_DATA_TOO_LARGE;
     }
     // Check if TX thread is ready to accept new data
     if ( handle->tx.origin_data )
     {
-        LOG(TINY_LOG_WRN, "[HDLC:%p] hdlc_ll_put FAILED\n", handle);
-        return TINY_ERR_BUSY;
+        if ( handle->tx.queue_len >= CONFIG_HDLC_LL_TX_QUEUE_SIZE )
+        {
+            LOG(TINY_LOG_WRN, "[HDLC:%p] hdlc_ll_put FAILED\n", handle);
+            return TINY_ERR_BUSY;
+        }
+        uint8_t index = (uint8_t)((handle->tx.queue_head + handle->tx.queue_len) % CONFIG_HDLC_LL_TX_QUEUE_SIZE);
+        handle->tx.queue[index].data = (const uint8_t *)data;
+        handle->tx.queue[index].len = len;
+        handle->tx.queue[index].segs = segs;
+        handle->tx.queue[index].segs_left = segs_left;
+        handle->tx.queue[index].crc = crc ? *crc : 0;
+        handle->tx.queue[index].crc_known = crc != NULL;
+        handle->tx.queue_len++;
+        LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_put QUEUED\n", handle);
+        return TINY_SUCCESS;
     }
     LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_put SUCCESS\n", handle);
-    handle->tx.origin_data = data;
-    handle->tx.data = data;
+    handle->tx.origin_data = (const uint8_t *)data;
+    handle->tx.data = (const uint8_t *)data;
     handle->tx.len = len;
+    handle->tx.segs = segs;
+    handle->tx.segs_left = segs_left;
+    handle->tx.frame_len = frame_len;
+    handle->tx.crc = crc ? *crc : 0;
+    handle->tx.crc_known = crc != NULL;
     return TINY_SUCCESS;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-static int hdlc_ll_read_start(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+int hdlc_ll_put(hdlc_ll_handle_t handle, const void *data, int len)
 {
-    if ( !len )
+    LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_put\n", handle);
+    if ( !len || !data || !handle )
     {
-        return 0;
+        return TINY_ERR_INVALID_DATA;
     }
-    if ( data[0] != FLAG_SEQUENCE )
+    return hdlc_ll_put_frame(handle, data, len, NULL, 0, len, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_put_with_crc(hdlc_ll_handle_t handle, const void *data, int len, uint32_t crc)
+{
+    LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_put_with_crc\n", handle);
+    if ( !len || !data || !handle )
     {
-        if ( data[0] != FILL_BYTE )
+        return TINY_ERR_INVALID_DATA;
+    }
+    crc_t value = (crc_t)crc;
+    return hdlc_ll_put_frame(handle, data, len, NULL, 0, len, &value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_put_iov(hdlc_ll_handle_t handle, const hdlc_ll_iov_t *segs, int count)
+{
+    LOG(TINY_LOG_DEB, "[HDLC:%p] hdlc_ll_put_iov\n", handle);
+    if ( !handle || !segs || count <= 0 || count > 255 )
+    {
+        return TINY_ERR_INVALID_DATA;
+    }
+    // Skip leading empty segments, so that the frame always starts with some data
+    while ( count && !segs->len )
+    {
+        segs++;
+        count--;
+    }
+    int frame_len = 0;
+    for ( int i = 0; i < count; i++ )
+    {
+        if ( segs[i].len < 0 || (segs[i].len && !segs[i].data) )
         {
-            // TODO: Skip byte, but we received some wrong data
+            return TINY_ERR_INVALID_DATA;
         }
-        return 1;
+        frame_len += segs[i].len;
+    }
+    if ( !frame_len )
+    {
+        return TINY_ERR_INVALID_DATA;
     }
-    LOG(TINY_LOG_DEB, "[HDLC:%p] RX: %02X\n", handle, data[0]);
+    return hdlc_ll_put_frame(handle, segs[0].data, segs[0].len, segs + 1, (uint8_t)(count - 1), frame_len, NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void hdlc_ll_read_restart(hdlc_ll_handle_t handle)
+{
     handle->rx.escape = 0;
+    handle->rx.run = 0;
+    handle->rx.left = 0;
     handle->rx.data = (uint8_t *)handle->rx_buf;
-    handle->rx.state = hdlc_ll_read_data;
-    return 1;
+    handle->rx.crc = hdlc_ll_crc_init(handle->crc_type);
+    handle->rx.state = handle->framing->read_data;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_read_start(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+{
+    if ( !len )
+    {
+        return 0;
+    }
+    // Hunt mode: skip fill bytes and line noise up to the next flag at once
+    const uint8_t *flag = (const uint8_t *)memchr(data, handle->framing->delimiter, len);
+    if ( !flag )
+    {
+        STATS(handle->stats.discarded_bytes += len);
+        return len;
+    }
+    int skipped = (int)(flag - data);
+    STATS(handle->stats.discarded_bytes += skipped);
+    LOG(TINY_LOG_DEB, "[HDLC:%p] RX: %02X\n", handle, flag[0]);
+    hdlc_ll_read_restart(handle);
+    return skipped + 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -389,121 +791,257 @@ static int hdlc_ll_read_start(hdlc_ll_handle_t handle, const uint8_t *data, int
 static int hdlc_ll_read_data(hdlc_ll_handle_t handle, const uint8_t *data, int len)
 {
     int result = 0;
+    uint8_t *start = handle->rx.data;
+    uint8_t *end = (uint8_t *)handle->rx_buf + handle->rx_buf_size;
     while ( len > 0 )
     {
         uint8_t byte = data[0];
-        LOG(TINY_LOG_DEB, "[HDLC:%p] RX: %02X\n", handle, byte);
         if ( byte == FLAG_SEQUENCE )
         {
-            handle->rx.state = hdlc_ll_read_end;
+            LOG(TINY_LOG_DEB, "[HDLC:%p] RX: %02X\n", handle, byte);
             result++;
+            if ( handle->rx.data == handle->rx_buf && !handle->rx.escape )
+            {
+                // Back to back flags: previous closing flag and opening one, nothing to decode
+                data++;
+                len--;
+                continue;
+            }
+            handle->rx.state = hdlc_ll_read_end;
             break;
         }
+        int run = 1;
         if ( byte == TINY_ESCAPE_CHAR )
         {
             handle->rx.escape = 1;
         }
-        else if ( handle->rx.data - (uint8_t *)handle->rx_buf < handle->rx_buf_size )
+        else if ( handle->rx.escape )
         {
-            if ( handle->rx.escape )
+            if ( handle->rx.data < end )
             {
-                *handle->rx.data = byte ^ TINY_ESCAPE_BIT;
-                handle->rx.escape = 0;
+                *handle->rx.data++ = byte ^ TINY_ESCAPE_BIT;
             }
-            else
+            handle->rx.escape = 0;
+        }
+        else
+        {
+            // Copy clean run at once, bytes not fitting rx buffer are dropped
+            run = hdlc_ll_find_special(data, len);
+            if ( handle->rx.zero_copy && handle->rx.data == handle->rx_buf && run < len && data[run] == FLAG_SEQUENCE )
             {
-                *handle->rx.data = byte;
+                // Whole frame without escapes is in the input buffer: deliver it in place, without copying.
+                // rx.left keeps the frame length, hdlc_ll_read_end() finds the frame just before the closing flag
+                handle->rx.crc = hdlc_ll_crc_update(handle->crc_type, handle->rx.crc, data, run);
+                handle->rx.left = run;
+                handle->rx.state = hdlc_ll_read_end;
+                return result + run + 1;
             }
-            handle->rx.data++;
-            // LOG(TINY_LOG_DEB, "%02X\n", handle->rx.data[ handle->rx.len ]);
+            int room = (int)(end - handle->rx.data);
+            memcpy(handle->rx.data, data, run < room ? run : room);
+            handle->rx.data += run < room ? run : room;
         }
-        result++;
-        data++;
-        len--;
+#if TINY_HDLC_DEBUG
+        for ( int i = 0; i < run; i++ )
+            LOG(TINY_LOG_DEB, "[HDLC:%p] RX: %02X\n", handle, data[i]);
+#endif
+        result += run;
+        data += run;
+        len -= run;
     }
+    // Unescaped bytes are still hot in the cache
+    handle->rx.crc = hdlc_ll_crc_update(handle->crc_type, handle->rx.crc, start, (int)(handle->rx.data - start));
     return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-static int hdlc_ll_read_end(hdlc_ll_handle_t handle, const uint8_t *data, int len_bytes)
+/*
+ * Table driven decoder. The state of the decoder is just "escape pending" bit. 256-entry table maps
+ * every byte to DFA action: data byte is stored, escape char sets the escape bit, flag ends the frame.
+ * Stored byte is unescaped by xor with escape bit << 5 and escape bit is updated from the table, so
+ * the inner loop has no data dependent branches except the end of the frame.
+ */
+
+#define HDLC_DFA_ESCAPE 0x01
+#define HDLC_DFA_END 0x02
+
+static const uint8_t s_hdlc_dfa[256] = {
+    [FLAG_SEQUENCE] = HDLC_DFA_END,
+    [TINY_ESCAPE_CHAR] = HDLC_DFA_ESCAPE,
+};
+
+static int hdlc_ll_read_data_table(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+{
+    uint8_t *start = handle->rx.data;
+    uint8_t *out = handle->rx.data;
+    uint8_t *end = (uint8_t *)handle->rx_buf + handle->rx_buf_size;
+    uint8_t state = handle->rx.escape;
+    int pos = 0;
+    while ( pos < len )
+    {
+        // Each byte advances output pointer at most by one, so no bounds check is needed within the block
+        int room = (int)(end - out);
+        int block = len - pos < room ? len - pos : room;
+        uint8_t entry = 0;
+        for ( int i = 0; i < block; i++ )
+        {
+            uint8_t byte = data[pos];
+            entry = s_hdlc_dfa[byte];
+            if ( entry & HDLC_DFA_END )
+            {
+                break;
+            }
+            // Repeated escape char keeps escape state and is not stored, as the default decoder does
+            *out = byte ^ (uint8_t)(state << 5);
+            out += 1 - (entry & HDLC_DFA_ESCAPE);
+            state = entry & HDLC_DFA_ESCAPE;
+            pos++;
+        }
+        if ( !block )
+        {
+            // Rx buffer is full: track frame end and escapes only, bytes are dropped
+            entry = s_hdlc_dfa[data[pos]];
+            if ( !(entry & HDLC_DFA_END) )
+            {
+                state = entry & HDLC_DFA_ESCAPE;
+                pos++;
+            }
+        }
+        if ( entry & HDLC_DFA_END )
+        {
+            pos++;
+            if ( out == handle->rx_buf && !state )
+            {
+                // Back to back flags: previous closing flag and opening one, nothing to decode
+                continue;
+            }
+            handle->rx.state = hdlc_ll_read_end;
+            break;
+        }
+    }
+    handle->rx.escape = state;
+    handle->rx.data = out;
+    handle->rx.crc = hdlc_ll_crc_update(handle->crc_type, handle->rx.crc, start, (int)(out - start));
+    return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool hdlc_ll_is_idle_fill(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+{
+    // Only HDLC framing uses fill bytes, COBS code byte 0xFF is valid start of the frame
+    if ( handle->framing->delimiter != FLAG_SEQUENCE )
+    {
+        return false;
+    }
+    while ( len && data[len - 1] == FILL_BYTE )
+    {
+        len--;
+    }
+    return len == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int hdlc_ll_drop_frame(hdlc_ll_handle_t handle, int error)
+{
+    (void)handle;
+    STATS(handle->stats.crc_errors++);
+    return error;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_read_end(hdlc_ll_handle_t handle, const uint8_t *data, int len_bytes)
 {
-    if ( handle->rx.data == handle->rx_buf )
+    // The frame is complete at this point, no user bytes are consumed by this state
+    (void)len_bytes;
+    uint8_t *frame = (uint8_t *)handle->rx_buf;
+    int len = (int)(handle->rx.data - frame);
+    if ( handle->rx.left )
+    {
+        // Frame is received in place, data points right after its closing flag
+        len = handle->rx.left;
+        frame = (uint8_t *)data - 1 - len;
+    }
+    if ( !len )
     {
         // Impossible, maybe frame alignment is wrong, go to read data again
         LOG(TINY_LOG_WRN, "[HDLC:%p] RX: error in frame alignment, recovering...\n", handle);
-        handle->rx.escape = 0;
-        handle->rx.state = hdlc_ll_read_data;
+        hdlc_ll_read_restart(handle);
         return 0; // That's OK, we actually didn't process anything from user bytes
     }
-    handle->rx.state = hdlc_ll_read_start;
-    int len = (int)(handle->rx.data - (uint8_t *)handle->rx_buf);
+    crc_t crc = handle->rx.crc;
+    uint8_t truncated = handle->rx.run;
+    // Closing flag is also the opening flag of the next frame (RFC 1662)
+    hdlc_ll_read_restart(handle);
+    if ( len < handle->rx.min_len )
+    {
+        // Too short to be a frame: line noise or break condition between frames
+        LOG(TINY_LOG_DEB, "[HDLC:%p] RX: runt of %d bytes is dropped\n", handle, len);
+        STATS(handle->stats.discarded_bytes += len);
+        return TINY_SUCCESS;
+    }
+    if ( truncated )
+    {
+        // Delimiter inside COBS block or length prefixed frame not fitting rx buffer
+        LOG(TINY_LOG_ERR, "[HDLC:%p] RX: truncated frame\n", handle);
+        return hdlc_ll_drop_frame(handle, TINY_ERR_WRONG_CRC);
+    }
     if ( len > handle->rx_buf_size )
     {
         // Buffer size issue, too long packet
         LOG(TINY_LOG_ERR, "[HDLC:%p] RX: tool long frame\n", handle);
-        return TINY_ERR_DATA_TOO_LARGE;
+        return hdlc_ll_drop_frame(handle, TINY_ERR_DATA_TOO_LARGE);
     }
-    if ( len < (uint8_t)handle->crc_type / 8 )
+    if ( !hdlc_ll_crc_is_good(handle->crc_type, crc) && hdlc_ll_is_idle_fill(handle, frame, len) )
     {
-        // CRC size issue
-        LOG(TINY_LOG_ERR, "[HDLC:%p] RX: crc field is too short\n", handle);
-        return TINY_ERR_WRONG_CRC;
+        // Not a frame, but fill bytes sent by remote side between flags, while the line is idle
+        STATS(handle->stats.discarded_bytes += len);
+        return TINY_SUCCESS;
     }
-    crc_t calc_crc = 0;
-    crc_t read_crc = 0;
-    switch ( handle->crc_type )
-    {
-#ifdef CONFIG_ENABLE_CHECKSUM
-        case HDLC_CRC_8:
-            calc_crc = tiny_chksum(INITCHECKSUM, handle->rx_buf, len - 1) & 0x00FF;
-            read_crc = handle->rx.data[-1];
-            break;
-#endif
-#ifdef CONFIG_ENABLE_FCS16
-        case HDLC_CRC_16:
-            calc_crc = tiny_crc16(PPPINITFCS16, handle->rx_buf, len - 2);
-            read_crc = handle->rx.data[-2] | ((uint16_t)handle->rx.data[-1] << 8);
-            break;
-#endif
-#ifdef CONFIG_ENABLE_FCS32
-        case HDLC_CRC_32:
-            calc_crc = tiny_crc32(PPPINITFCS32, handle->rx_buf, len - 4);
-            read_crc = handle->rx.data[-4] | ((uint32_t)handle->rx.data[-3] << 8) |
-                       ((uint32_t)handle->rx.data[-2] << 16) | ((uint32_t)handle->rx.data[-1] << 24);
-            break;
-#endif
-        default: break;
-    }
-    if ( calc_crc != read_crc )
+    if ( !hdlc_ll_crc_is_good(handle->crc_type, crc) )
     {
 // CRC calculate issue
 #if TINY_HDLC_DEBUG
-        LOG(TINY_LOG_ERR, "[HDLC:%p] RX: WRONG CRC (calc:%lu != %0lu)\n", handle, calc_crc, read_crc);
+        LOG(TINY_LOG_ERR, "[HDLC:%p] RX: WRONG CRC (residue:%08lX)\n", handle, (unsigned long)crc);
         if ( TINY_LOG_DEB < g_tiny_log_level )
             for ( int i = 0; i < len; i++ )
-                fprintf(stderr, " %c ", (char)((uint8_t *)handle->rx_buf)[i]);
+                fprintf(stderr, " %c ", (char)frame[i]);
         LOG(TINY_LOG_DEB, "%c\n", '_');
         if ( TINY_LOG_DEB < g_tiny_log_level )
             for ( int i = 0; i < len; i++ )
-                fprintf(stderr, " %02X ", ((uint8_t *)handle->rx_buf)[i]);
+                fprintf(stderr, " %02X ", frame[i]);
         LOG(TINY_LOG_DEB, "\n----------%c\n", '-');
 #endif
-        return TINY_ERR_WRONG_CRC;
+        return hdlc_ll_drop_frame(handle, TINY_ERR_WRONG_CRC);
     }
     len -= (uint8_t)handle->crc_type / 8;
-    // Shift back data pointer, pointing to the last byte after payload
-    handle->rx.data -= (uint8_t)handle->crc_type / 8;
     LOG(TINY_LOG_INFO, "[HDLC:%p] RX: Frame success: %d bytes\n", handle, len);
     if ( handle->on_frame_read )
     {
-        handle->on_frame_read(handle->user_data, handle->rx_buf, len);
+        handle->on_frame_read(handle->user_data, frame, len);
     }
     return TINY_SUCCESS;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void hdlc_ll_set_rx_buffer(hdlc_ll_handle_t handle, void *buf, int size)
+{
+    int (*state)(hdlc_ll_handle_t handle, const uint8_t *data, int len) = handle->rx.state;
+    handle->rx_buf = buf;
+    handle->rx_buf_size = size;
+    hdlc_ll_read_restart(handle);
+    if ( state == handle->framing->read_start )
+    {
+        // Keep hunting for the beginning of the frame
+        handle->rx.state = state;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 int hdlc_ll_run_rx(hdlc_ll_handle_t handle, const void *data, int len, int *error)
 {
     int result = 0;
@@ -531,6 +1069,171 @@ int hdlc_ll_run_rx(hdlc_ll_handle_t handle, const void *data, int len, int *erro
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+static uint8_t *hdlc_ll_escape_block(uint8_t *out, const uint8_t *end, const uint8_t *data, int len)
+{
+    while ( len > 0 )
+    {
+        int run = hdlc_ll_find_special(data, len);
+        if ( run )
+        {
+            if ( end - out < run )
+            {
+                return NULL;
+            }
+            memcpy(out, data, run);
+            out += run;
+            data += run;
+            len -= run;
+        }
+        else
+        {
+            if ( end - out < 2 )
+            {
+                return NULL;
+            }
+            out[0] = TINY_ESCAPE_CHAR;
+            out[1] = data[0] ^ TINY_ESCAPE_BIT;
+            out += 2;
+            data++;
+            len--;
+        }
+    }
+    return out;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_encode_frame(void *dst, int dst_len, const void *src, int len, hdlc_crc_t crc_type)
+{
+    if ( len <= 0 || !src )
+    {
+        return TINY_ERR_INVALID_DATA;
+    }
+    crc_type = crc_type == HDLC_CRC_OFF ? 0 : crc_type;
+    uint8_t *out = (uint8_t *)dst;
+    const uint8_t *end = out + dst_len;
+    if ( dst_len < 2 )
+    {
+        return TINY_ERR_DATA_TOO_LARGE;
+    }
+    *out++ = FLAG_SEQUENCE;
+    out = hdlc_ll_escape_block(out, end, (const uint8_t *)src, len);
+    if ( out && crc_type )
+    {
+        crc_t crc = hdlc_ll_crc_update(crc_type, hdlc_ll_crc_init(crc_type), (const uint8_t *)src, len);
+        crc = hdlc_ll_crc_final(crc_type, crc);
+        uint8_t fcs[sizeof(crc_t)];
+        for ( int i = 0; i < get_crc_field_size(crc_type); i++ )
+        {
+            fcs[i] = (uint8_t)(crc >> (8 * i));
+        }
+        out = hdlc_ll_escape_block(out, end, fcs, get_crc_field_size(crc_type));
+    }
+    if ( !out || out == end )
+    {
+        return TINY_ERR_DATA_TOO_LARGE;
+    }
+    *out++ = FLAG_SEQUENCE;
+    return (int)(out - (uint8_t *)dst);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void hdlc_ll_decode_frame(const uint8_t *data, int len, uint8_t *buf, int buf_size, hdlc_crc_t crc_type,
+                                 int (*on_frame_read)(void *user_data, void *data, int len), void *user_data)
+{
+    uint8_t *out = buf;
+    while ( len > 0 )
+    {
+        int run = hdlc_ll_find_special(data, len);
+        if ( run )
+        {
+            if ( buf + buf_size - out < run )
+            {
+                LOG(TINY_LOG_ERR, "[HDLC:%p] RX: tool long frame\n", buf);
+                return;
+            }
+            memcpy(out, data, run);
+            out += run;
+            data += run;
+            len -= run;
+        }
+        else
+        {
+            // The frame cannot contain flags, so this is escape char
+            if ( len < 2 || out == buf + buf_size )
+            {
+                return;
+            }
+            *out++ = data[1] ^ TINY_ESCAPE_BIT;
+            data += 2;
+            len -= 2;
+        }
+    }
+    int frame_len = (int)(out - buf) - get_crc_field_size(crc_type);
+    if ( frame_len <= 0 )
+    {
+        return;
+    }
+    crc_t crc = hdlc_ll_crc_update(crc_type, hdlc_ll_crc_init(crc_type), buf, (int)(out - buf));
+    if ( !hdlc_ll_crc_is_good(crc_type, crc) )
+    {
+        LOG(TINY_LOG_ERR, "[HDLC:%p] RX: WRONG CRC (residue:%08lX)\n", buf, (unsigned long)crc);
+        return;
+    }
+    if ( on_frame_read )
+    {
+        on_frame_read(user_data, buf, frame_len);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_decode_buffer(const void *src, int len, void *buf, int buf_size, hdlc_crc_t crc_type,
+                          int (*on_frame_read)(void *user_data, void *data, int len), void *user_data)
+{
+    crc_type = crc_type == HDLC_CRC_OFF ? 0 : crc_type;
+    const uint8_t *data = (const uint8_t *)src;
+    const uint8_t *start = (const uint8_t *)memchr(data, FLAG_SEQUENCE, len);
+    if ( !start )
+    {
+        // No frames, all bytes are garbage
+        return len;
+    }
+    for ( ;; )
+    {
+        // Closing flag of the frame can be opening flag of the next one
+        const uint8_t *flag = (const uint8_t *)memchr(start + 1, FLAG_SEQUENCE, (data + len) - (start + 1));
+        if ( !flag )
+        {
+            break;
+        }
+        if ( flag - start > 1 )
+        {
+            hdlc_ll_decode_frame(start + 1, (int)(flag - start - 1), (uint8_t *)buf, buf_size, crc_type,
+                                 on_frame_read, user_data);
+        }
+        start = flag;
+    }
+    return (int)(start - data);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+int hdlc_ll_get_stats(hdlc_ll_handle_t handle, hdlc_ll_stats_t *stats)
+{
+#ifdef CONFIG_ENABLE_STATS
+    *stats = handle->stats;
+    return TINY_SUCCESS;
+#else
+    (void)handle;
+    (void)stats;
+    return TINY_ERR_FAILED;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 int hdlc_ll_get_buf_size(int mtu)
 {
     // TINY_ALIGN_STRUCT_VALUE is added to satisfy alignment requirements
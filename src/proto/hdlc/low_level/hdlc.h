@@ -40,6 +40,9 @@ extern "C"
 /** Byte to fill gap between frames */
 #define TINY_HDLC_FILL_BYTE 0xFF
 
+/** Maximum size of hdlc frame for payload of len bytes, when all bytes need escaping */
+#define HDLC_LL_ENCODED_MAX_SIZE(len, crc) (2 * ((len) + ((crc) == HDLC_CRC_OFF ? 0 : (int)(crc) / 8)) + 2)
+
     /**
      * @defgroup HDLC_LOW_LEVEL_API HDLC low level protocol API
      * @{
@@ -62,6 +65,23 @@ extern "C"
         HDLC_LL_RESET_RX_ONLY = 0x02,
     } hdlc_ll_reset_flags_t;
 
+    /**
+     * Framing used by hdlc low level to delimit frames in the byte stream
+     */
+    typedef enum
+    {
+        /** RFC 1662 framing: 0x7E flags, 0x7D escape sequences. Worst case overhead is 100% */
+        HDLC_FRAMING_HDLC = 0,
+        /** Consistent Overhead Byte Stuffing: 0x00 delimiters, 1 byte overhead per 254 bytes */
+        HDLC_FRAMING_COBS = 1,
+        /**
+         * 16-bit little endian length prefix, no delimiters and no escaping. Frames are limited to 65535 bytes
+         * including crc field. There is no resynchronization, so use it only over reliable byte streams
+         * (TCP, unix sockets, vsock), usually with HDLC_CRC_OFF.
+         */
+        HDLC_FRAMING_LENGTH = 2,
+    } hdlc_framing_t;
+
     struct hdlc_ll_data_t;
 
     /** Handle for HDLC low level protocol */
@@ -119,8 +139,59 @@ extern "C"
 
         /** User data, which will be passed to user-defined callback as first argument */
         void *user_data;
+
+        /**
+         * Framing to use. Zero value selects standard HDLC framing (HDLC_FRAMING_HDLC).
+         * Both sides of the link must use the same framing.
+         */
+        hdlc_framing_t framing;
+
+        /**
+         * If true, HDLC frames without escape sequences, which are completely available in the buffer passed to
+         * hdlc_ll_run_rx(), are passed to on_frame_read callback in place, without copying to rx buffer.
+         * In this case callback gets pointer to the input buffer, which is not aligned and must not be modified.
+         */
+        bool zero_copy_rx;
+
+        /**
+         * If true, HDLC framing is decoded by table driven state machine instead of the default decoder,
+         * which copies runs of bytes without special characters at once. Table decoder has stable speed
+         * on any data, including noise and payloads full of escaped bytes. zero_copy_rx is not
+         * supported by table decoder.
+         */
+        bool table_decoder;
+
+        /**
+         * Minimum length of the frame without crc field. Shorter data between delimiters, like line noise
+         * or break condition on UART, is not reported as crc error, but dropped silently and counted as
+         * discarded bytes. Zero value means 1 byte.
+         */
+        uint8_t min_frame_len;
     } hdlc_ll_init_t;
 
+    /**
+     * Receive statistics of hdlc low level. Available only if library is built with
+     * CONFIG_ENABLE_STATS.
+     */
+    typedef struct
+    {
+        /** Number of bytes skipped while hunting for opening flag: fill bytes and line noise */
+        uint32_t discarded_bytes;
+        /** Number of frames dropped because of wrong crc or too long length */
+        uint32_t crc_errors;
+    } hdlc_ll_stats_t;
+
+    /**
+     * Segment of the frame for hdlc_ll_put_iov(), similar to struct iovec
+     */
+    typedef struct
+    {
+        /** pointer to segment data */
+        const void *data;
+        /** size of segment data in bytes */
+        int len;
+    } hdlc_ll_iov_t;
+
     //------------------------ GENERIC FUNCIONS ------------------------------
 
     /**
@@ -149,6 +220,23 @@ extern "C"
      */
     void hdlc_ll_reset(hdlc_ll_handle_t handle, uint8_t flags);
 
+    /**
+     * Drops frames, queued for sending, but not started yet. The frame being sent is not interrupted.
+     * on_frame_sent callback is called for every dropped frame, so that their buffers can be released.
+     *
+     * @param handle hdlc handle
+     */
+    void hdlc_ll_flush(hdlc_ll_handle_t handle);
+
+    /**
+     * Returns receive statistics.
+     *
+     * @param handle hdlc handle
+     * @param stats pointer to structure to fill with statistics
+     * @return TINY_SUCCESS, or TINY_ERR_FAILED if library is built without CONFIG_ENABLE_STATS
+     */
+    int hdlc_ll_get_stats(hdlc_ll_handle_t handle, hdlc_ll_stats_t *stats);
+
     //------------------------ RX FUNCIONS ------------------------------
 
     /**
@@ -182,6 +270,18 @@ extern "C"
      */
     int hdlc_ll_run_rx(hdlc_ll_handle_t handle, const void *data, int len, int *error);
 
+    /**
+     * Switches hdlc level to another buffer for incoming frames. The function is intended to be
+     * called from on_frame_read callback, so that the buffer with received frame can be kept by
+     * the user, while next frames are decoded to new buffer. Partially received frame, if any, is
+     * discarded.
+     *
+     * @param handle hdlc handle
+     * @param buf pointer to buffer to receive next frames to
+     * @param size size of the buffer in bytes, must fit largest frame with crc field
+     */
+    void hdlc_ll_set_rx_buffer(hdlc_ll_handle_t handle, void *buf, int size);
+
     //------------------------ TX FUNCIONS ------------------------------
 
     /**
@@ -202,11 +302,13 @@ extern "C"
      * hdlc_ll_put() function will not wait or perform send operation, but only pass data pointer to
      * hdlc state machine. In this case, some other thread needs to
      * or in the same thread you need to send data using hdlc_ll_get_tx_data().
+     * If another frame is being sent, the new one is queued (up to CONFIG_HDLC_LL_TX_QUEUE_SIZE
+     * frames). Queued frames are sent back to back with single flag between them.
      *
      * @param handle hdlc handle
      * @param data pointer to new data to send
      * @param len size of data to send in bytes
-     * @return TINY_ERR_BUSY if TX queue is busy with another frame.
+     * @return TINY_ERR_BUSY if TX queue is full.
      *         TINY_ERR_INVALID_DATA if len is zero.
      *         TINY_SUCCESS if data is successfully sent
      * @warning buffer with data must be available all the time until
@@ -218,6 +320,97 @@ extern "C"
      */
     int hdlc_ll_put(hdlc_ll_handle_t handle, const void *data, int len);
 
+    /**
+     * Puts next frame, consisting of several non-contiguous segments, for sending.
+     * Segments are encoded one after another as single frame with single crc field, so
+     * the header and the payload of the frame can be kept in separate buffers without copying.
+     * on_frame_sent callback receives pointer to the first non-empty segment and total frame length.
+     *
+     * @param handle hdlc handle
+     * @param segs array of frame segments, empty segments are skipped
+     * @param count number of segments in the array (up to 255)
+     * @return TINY_ERR_BUSY if TX queue is full.
+     *         TINY_ERR_INVALID_DATA if the frame is empty.
+     *         TINY_ERR_DATA_TOO_LARGE if the frame is too long for the framing in use.
+     *         TINY_SUCCESS if data is successfully sent
+     * @warning both segments array and segments data must be available until on_frame_sent
+     *          callback is called for the frame.
+     */
+    int hdlc_ll_put_iov(hdlc_ll_handle_t handle, const hdlc_ll_iov_t *segs, int count);
+
+    /**
+     * Puts next frame for sending, using already known value of crc field instead of calculating it.
+     * This is useful for retransmitted frames: crc of the unchanged part can be kept, and
+     * combined with crc of the changed header via hdlc_ll_crc_combine().
+     *
+     * @param handle hdlc handle
+     * @param data pointer to new data to send
+     * @param len size of data to send in bytes
+     * @param crc crc field value for the data, as returned by hdlc_ll_crc()
+     * @return the same codes as hdlc_ll_put()
+     */
+    int hdlc_ll_put_with_crc(hdlc_ll_handle_t handle, const void *data, int len, uint32_t crc);
+
+    /**
+     * Calculates value of crc field for the specified data.
+     *
+     * @param crc_type type of crc field
+     * @param data pointer to data
+     * @param len size of data in bytes
+     * @return crc field value, 0 for HDLC_CRC_OFF
+     */
+    uint32_t hdlc_ll_crc(hdlc_crc_t crc_type, const void *data, int len);
+
+    /**
+     * Calculates value of crc field for two adjacent blocks of data from hdlc_ll_crc() results
+     * of each block, without reading the data.
+     *
+     * @param crc_type type of crc field
+     * @param crc1 hdlc_ll_crc() result for the first block
+     * @param crc2 hdlc_ll_crc() result for the second block
+     * @param len2 length of the second block in bytes
+     * @return crc field value for the first block followed by the second one
+     */
+    uint32_t hdlc_ll_crc_combine(hdlc_crc_t crc_type, uint32_t crc1, uint32_t crc2, int len2);
+
+    //------------------------ ONE-SHOT FUNCIONS ------------------------------
+
+    /**
+     * Encodes the whole frame (flags, escaped payload and crc field) to the specified buffer
+     * at once. Doesn't require hdlc handle, and can be used when the payload and large enough
+     * output buffer are available. Use HDLC_LL_ENCODED_MAX_SIZE() to calculate output buffer size,
+     * which fits any payload of specified length.
+     *
+     * @param dst pointer to the buffer to write hdlc frame to
+     * @param dst_len size of the output buffer in bytes
+     * @param src pointer to payload
+     * @param len size of payload in bytes
+     * @param crc_type type of crc field to add to the frame
+     * @return size of encoded frame in bytes, or
+     *         TINY_ERR_INVALID_DATA if len is zero.
+     *         TINY_ERR_DATA_TOO_LARGE if output buffer is too small.
+     */
+    int hdlc_ll_encode_frame(void *dst, int dst_len, const void *src, int len, hdlc_crc_t crc_type);
+
+    /**
+     * Decodes all complete frames in the specified buffer. on_frame_read callback is called
+     * for each frame with valid crc, frames with wrong crc or too long for the buffer are dropped.
+     * The function doesn't keep the state between calls: if the buffer ends with incomplete frame,
+     * the bytes starting from its opening flag are not processed, and must be passed again
+     * together with the next portion of data.
+     *
+     * @param src pointer to data to decode
+     * @param len size of data in bytes
+     * @param buf buffer to decode frames to, must fit payload and crc field
+     * @param buf_size size of the buffer in bytes
+     * @param crc_type type of crc field used in frames
+     * @param on_frame_read callback to call for each successfully decoded frame
+     * @param user_data user data to pass to the callback
+     * @return number of processed bytes
+     */
+    int hdlc_ll_decode_buffer(const void *src, int len, void *buf, int buf_size, hdlc_crc_t crc_type,
+                              int (*on_frame_read)(void *user_data, void *data, int len), void *user_data);
+
     /**
      * Returns minimum buffer size, required to hold hdlc low level data for desired payload size.
      *
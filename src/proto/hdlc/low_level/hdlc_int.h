@@ -52,6 +52,36 @@ extern "C"
  */
 #define HDLC_MIN_BUF_SIZE(mtu, crc) (sizeof(hdlc_ll_data_t) + (int)(crc) / 8 + (mtu) + TINY_ALIGN_STRUCT_VALUE - 1)
 
+#ifndef CONFIG_HDLC_LL_TX_QUEUE_SIZE
+/**
+ * Number of frames, which can wait in hdlc_ll TX queue in addition to the frame being sent.
+ * Frames from the queue are sent back to back, sharing single flag between frames.
+ */
+#define CONFIG_HDLC_LL_TX_QUEUE_SIZE 3
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    /**
+     * Framing specific part of hdlc low level state machine. Queue, crc check and callbacks
+     * are common for all framings. Delimiter based framings use common start and end states.
+     */
+    typedef struct
+    {
+        /** Byte delimiting frames in the stream */
+        uint8_t delimiter;
+        /** Maximum length of the frame body (user data and crc field), 0 if unlimited */
+        int max_len;
+        /** RX state waiting for the beginning of the frame, entered on reset */
+        int (*read_start)(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+        /** RX state decoding frame body up to the end of the frame */
+        int (*read_data)(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+        /** TX state waiting for the frame to send, entered on reset */
+        int (*send_start)(hdlc_ll_handle_t handle);
+        /** TX state encoding frame body and crc field after the opening delimiter */
+        int (*send_data)(hdlc_ll_handle_t handle);
+    } hdlc_ll_framing_t;
+#endif
+
     /**
      * Structure describes configuration of lowest HDLC level
      * Initialize this structure by 0 before passing to hdlc_ll_init()
@@ -106,26 +136,70 @@ extern "C"
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
         /** Parameters in DOXYGEN_SHOULD_SKIP_THIS section should not be modified by a user */
+        const hdlc_ll_framing_t *framing;
         struct
         {
             int (*state)(hdlc_ll_handle_t handle, const uint8_t *data, int len);
             uint8_t *data;
+            crc_t crc;
             uint8_t escape;
+            uint8_t run;       // COBS: bytes left in current block
+            uint8_t zero_copy; // Frames without escapes can be delivered in place
+            int left;          // Length prefixed: bytes of frame body left to receive, HDLC: in place frame length
+            int min_len;       // Shorter frame bodies, including crc field, are runts and dropped silently
         } rx;
         struct
         {
             int (*state)(hdlc_ll_handle_t handle);
             uint8_t *out_buffer;
-            int out_buffer_len;
             const uint8_t *origin_data;
-            const uint8_t *data;
+            const uint8_t *data;       // Current segment
+            const hdlc_ll_iov_t *segs; // Segments following the current one
+            int out_buffer_len;
             int len;
+            int frame_len;
             crc_t crc;
+            uint8_t segs_left;
+            uint8_t crc_known; // tx.crc holds final crc of the frame, provided by the user
             uint8_t escape;
+            uint8_t run;  // COBS: bytes left in current block
+            uint8_t tail; // COBS: crc field bytes left to send
+            struct
+            {
+                const uint8_t *data;
+                const hdlc_ll_iov_t *segs;
+                int len;
+                crc_t crc;
+                uint8_t segs_left;
+                uint8_t crc_known;
+            } queue[CONFIG_HDLC_LL_TX_QUEUE_SIZE];
+            uint8_t queue_head;
+            uint8_t queue_len;
         } tx;
+#ifdef CONFIG_ENABLE_STATS
+        hdlc_ll_stats_t stats;
+#endif
 #endif
     } hdlc_ll_data_t;
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+    /* Functions shared between framing implementations of hdlc low level */
+    extern const hdlc_ll_framing_t hdlc_ll_framing_cobs;
+    extern const hdlc_ll_framing_t hdlc_ll_framing_length;
+
+    crc_t hdlc_ll_crc_init(hdlc_crc_t crc_type);
+    crc_t hdlc_ll_crc_update(hdlc_crc_t crc_type, crc_t crc, const uint8_t *data, int len);
+    crc_t hdlc_ll_crc_final(hdlc_crc_t crc_type, crc_t crc);
+    int hdlc_ll_send_tx_internal(hdlc_ll_handle_t handle, const void *data, int len);
+    int hdlc_ll_send_start(hdlc_ll_handle_t handle);
+    int hdlc_ll_send_end(hdlc_ll_handle_t handle);
+    bool hdlc_ll_send_complete(hdlc_ll_handle_t handle);
+    bool hdlc_ll_next_segment(hdlc_ll_handle_t handle);
+    crc_t hdlc_ll_crc_frame(hdlc_ll_handle_t handle);
+    int hdlc_ll_read_start(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+    int hdlc_ll_read_end(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+#endif
+
     /**
      * @}
      */
@@ -0,0 +1,173 @@
+/*
+    Copyright 2022 (C) Alexey Dynda
+
+    This file is part of Tiny Protocol Library.
+
+    GNU General Public License Usage
+
+    Protocol Library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Protocol Library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Protocol Library.  If not, see <http://www.gnu.org/licenses/>.
+
+    Commercial License Usage
+
+    Licensees holding valid commercial Tiny Protocol licenses may use this file in
+    accordance with the commercial license agreement provided in accordance with
+    the terms contained in a written agreement between you and Alexey Dynda.
+    For further information contact via email on github account.
+*/
+
+/*
+ * Length prefixed framing for hdlc low level.
+ *
+ *     16       any len    0-32
+ * | LENGTH | DATA ... | CRC |
+ *
+ * LENGTH is little endian size of DATA and CRC fields together. Frame body is sent as is,
+ * so both sides just copy the data. There are no delimiters, thus the receiver cannot
+ * resynchronize after lost or corrupted bytes: use this framing only over reliable byte
+ * streams (TCP, unix sockets, vsock), where crc field can be disabled too.
+ * Zero LENGTH is valid and can be used as keep-alive, such frames are skipped by the receiver.
+ */
+
+#include "hdlc.h"
+#include "hdlc_int.h"
+#include "proto/crc/tiny_crc.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define LENGTH_FIELD_SIZE 2
+#define LENGTH_MAX 0xFFFF
+
+static int length_ll_read_header(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+static int length_ll_read_body(hdlc_ll_handle_t handle, const uint8_t *data, int len);
+
+static int length_ll_send_header(hdlc_ll_handle_t handle);
+static int length_ll_send_body(hdlc_ll_handle_t handle);
+
+const hdlc_ll_framing_t hdlc_ll_framing_length = {
+    .delimiter = 0,
+    .max_len = LENGTH_MAX,
+    .read_start = length_ll_read_header,
+    .read_data = length_ll_read_header,
+    .send_start = length_ll_send_header,
+    .send_data = length_ll_send_body,
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int length_ll_send_header(hdlc_ll_handle_t handle)
+{
+    if ( !handle->tx.origin_data )
+    {
+        return 0;
+    }
+    if ( !handle->tx.escape )
+    {
+        // Crc field is sent right after user data, so it is calculated before sending the frame
+        handle->tx.crc = hdlc_ll_crc_frame(handle);
+        handle->tx.tail = get_crc_field_size(handle->crc_type);
+    }
+    int body_len = handle->tx.frame_len + handle->tx.tail;
+    uint8_t header[LENGTH_FIELD_SIZE] = {(uint8_t)body_len, (uint8_t)(body_len >> 8)};
+    // tx.escape holds number of length field bytes already sent
+    int result = hdlc_ll_send_tx_internal(handle, header + handle->tx.escape, LENGTH_FIELD_SIZE - handle->tx.escape);
+    handle->tx.escape += result;
+    if ( handle->tx.escape == LENGTH_FIELD_SIZE )
+    {
+        handle->tx.escape = 0;
+        handle->tx.state = length_ll_send_body;
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int length_ll_send_body(hdlc_ll_handle_t handle)
+{
+    int result;
+    if ( handle->tx.len )
+    {
+        result = hdlc_ll_send_tx_internal(handle, handle->tx.data, handle->tx.len);
+        handle->tx.data += result;
+        handle->tx.len -= result;
+        if ( !handle->tx.len )
+        {
+            hdlc_ll_next_segment(handle);
+        }
+    }
+    else
+    {
+        uint8_t fcs[4];
+        int size = get_crc_field_size(handle->crc_type);
+        for ( int i = 0; i < size; i++ )
+        {
+            fcs[i] = (uint8_t)(handle->tx.crc >> (i * 8));
+        }
+        result = hdlc_ll_send_tx_internal(handle, fcs + size - handle->tx.tail, handle->tx.tail);
+        handle->tx.tail -= result;
+    }
+    if ( !handle->tx.len && !handle->tx.tail )
+    {
+        // Next frame (queued or put from the callback) starts with its length field
+        hdlc_ll_send_complete(handle);
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int length_ll_read_header(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+{
+    int result = 0;
+    // rx.escape holds number of length field bytes already received
+    while ( len > 0 && handle->rx.escape < LENGTH_FIELD_SIZE )
+    {
+        handle->rx.left |= data[result] << (handle->rx.escape * 8);
+        handle->rx.escape++;
+        result++;
+        len--;
+    }
+    if ( handle->rx.escape == LENGTH_FIELD_SIZE )
+    {
+        handle->rx.escape = 0;
+        if ( handle->rx.left )
+        {
+            handle->rx.state = length_ll_read_body;
+        }
+    }
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static int length_ll_read_body(hdlc_ll_handle_t handle, const uint8_t *data, int len)
+{
+    int result = len < handle->rx.left ? len : handle->rx.left;
+    int room = (int)((uint8_t *)handle->rx_buf + handle->rx_buf_size - handle->rx.data);
+    if ( result > room )
+    {
+        // Frame does not fit rx buffer, skip the rest of it and drop the frame
+        handle->rx.run = 1;
+    }
+    int copied = result < room ? result : room;
+    memcpy(handle->rx.data, data, copied);
+    handle->rx.crc = hdlc_ll_crc_update(handle->crc_type, handle->rx.crc, handle->rx.data, copied);
+    handle->rx.data += copied;
+    handle->rx.left -= result;
+    if ( !handle->rx.left )
+    {
+        handle->rx.state = hdlc_ll_read_end;
+    }
+    return result;
+}
@@ -80,6 +80,7 @@ int tiny_light_init(STinyLightData *handle, write_block_cb_t write_func, read_bl
     init.buf = &handle->buffer[0];
     init.buf_size = LIGHT_BUF_SIZE;
     init.crc_type = ((STinyLightData *)handle)->crc_type;
+    init.framing = ((STinyLightData *)handle)->framing;
 
     handle->user_data = pdata;
     handle->read_func = read_func;
@@ -78,6 +78,8 @@ extern "C"
         void *user_data;
         /// CRC type to use
         hdlc_crc_t crc_type;
+        /// Framing to use, HDLC_FRAMING_HDLC by default
+        hdlc_framing_t framing;
     } STinyLightData;
 
     /**
@@ -0,0 +1,206 @@
+/*
+    Copyright 2022 (C) Alexey Dynda
+
+    This file is part of Tiny Protocol Library.
+
+    GNU General Public License Usage
+
+    Protocol Library is free software: you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    Protocol Library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public License
+    along with Protocol Library.  If not, see <http://www.gnu.org/licenses/>.
+
+    Commercial License Usage
+
+    Licensees holding valid commercial Tiny Protocol licenses may use this file in
+    accordance with the commercial license agreement provided in accordance with
+    the terms contained in a written agreement between you and Alexey Dynda.
+    For further information contact via email on github account.
+*/
+
+#include <CppUTest/TestHarness.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "proto/crc/tiny_crc.h"
+#include "TinyCrc.h"
+
+static const uint8_t s_check_data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+#ifdef CONFIG_ENABLE_FCS16
+static uint16_t crc16_reference(const uint8_t *data, int len)
+{
+    uint16_t crc = PPPINITFCS16;
+    while ( len-- )
+        crc = crc16_byte(crc, *data++);
+    return crc ^ 0xFFFF;
+}
+#endif
+
+#ifdef CONFIG_ENABLE_FCS32
+static uint32_t crc32_reference(const uint8_t *data, int len)
+{
+    uint32_t crc = PPPINITFCS32;
+    while ( len-- )
+        crc = crc32_byte(crc, *data++);
+    return crc ^ 0xFFFFFFFF;
+}
+#endif
+
+static void fill_random(uint8_t *buf, int len)
+{
+    for ( int i = 0; i < len; i++ )
+        buf[i] = (uint8_t)rand();
+}
+
+#ifdef CONFIG_ENABLE_FCS32C
+static uint32_t crc32c_reference(const uint8_t *data, int len)
+{
+    uint32_t crc = PPPINITFCS32C;
+    while ( len-- )
+        crc = crc32c_byte(crc, *data++);
+    return crc ^ 0xFFFFFFFF;
+}
+#endif
+
+TEST_GROUP(CRC){void setup(){
+    srand(1);
+}
+
+                void teardown(){
+                    // ...
+                }};
+
+#ifdef CONFIG_ENABLE_FCS16
+TEST(CRC, crc16_check_value)
+{
+    CHECK_EQUAL(0x906E, tiny_crc16(PPPINITFCS16, s_check_data, sizeof(s_check_data)));
+}
+
+TEST(CRC, crc16_matches_bytewise)
+{
+    uint8_t buf[1024 + 16];
+    fill_random(buf, sizeof(buf));
+    for ( int len = 0; len <= 1024; len += (len < 160 ? 1 : 37) )
+    {
+        for ( int offset = 0; offset < 16; offset += 5 )
+        {
+            CHECK_EQUAL(crc16_reference(buf + offset, len), tiny_crc16(PPPINITFCS16, buf + offset, len));
+        }
+    }
+}
+
+TEST(CRC, crc16_combine)
+{
+    uint8_t buf[600];
+    fill_random(buf, sizeof(buf));
+    uint16_t whole = tiny_crc16(PPPINITFCS16, buf, sizeof(buf));
+    for ( int split = 0; split <= (int)sizeof(buf); split += 23 )
+    {
+        uint16_t crc1 = tiny_crc16(PPPINITFCS16, buf, split);
+        uint16_t crc2 = tiny_crc16(PPPINITFCS16, buf + split, sizeof(buf) - split);
+        CHECK_EQUAL(whole, crc16_combine(crc1, crc2, sizeof(buf) - split));
+    }
+}
+#endif
+
+#ifdef CONFIG_ENABLE_FCS32
+TEST(CRC, crc32_check_value)
+{
+    CHECK_EQUAL(0xCBF43926, tiny_crc32(PPPINITFCS32, s_check_data, sizeof(s_check_data)));
+}
+
+TEST(CRC, crc32_matches_bytewise)
+{
+    uint8_t buf[1024 + 16];
+    fill_random(buf, sizeof(buf));
+    for ( int len = 0; len <= 1024; len += (len < 160 ? 1 : 37) )
+    {
+        for ( int offset = 0; offset < 16; offset += 5 )
+        {
+            CHECK_EQUAL(crc32_reference(buf + offset, len), tiny_crc32(PPPINITFCS32, buf + offset, len));
+        }
+    }
+}
+
+TEST(CRC, crc32_combine)
+{
+    uint8_t buf[600];
+    fill_random(buf, sizeof(buf));
+    uint32_t whole = tiny_crc32(PPPINITFCS32, buf, sizeof(buf));
+    for ( int split = 0; split <= (int)sizeof(buf); split += 23 )
+    {
+        uint32_t crc1 = tiny_crc32(PPPINITFCS32, buf, split);
+        uint32_t crc2 = tiny_crc32(PPPINITFCS32, buf + split, sizeof(buf) - split);
+        CHECK_EQUAL(whole, crc32_combine(crc1, crc2, sizeof(buf) - split));
+    }
+}
+#endif
+
+#ifdef CONFIG_ENABLE_FCS32C
+TEST(CRC, crc32c_check_value)
+{
+    CHECK_EQUAL(0xE3069283, tiny_crc32c(PPPINITFCS32C, s_check_data, sizeof(s_check_data)));
+}
+
+TEST(CRC, crc32c_matches_bytewise)
+{
+    uint8_t buf[1024 + 16];
+    fill_random(buf, sizeof(buf));
+    for ( int len = 0; len <= 1024; len += (len < 160 ? 1 : 37) )
+    {
+        for ( int offset = 0; offset < 16; offset += 5 )
+        {
+            CHECK_EQUAL(crc32c_reference(buf + offset, len), tiny_crc32c(PPPINITFCS32C, buf + offset, len));
+        }
+    }
+}
+
+TEST(CRC, crc32c_combine)
+{
+    uint8_t buf[600];
+    fill_random(buf, sizeof(buf));
+    uint32_t whole = tiny_crc32c(PPPINITFCS32C, buf, sizeof(buf));
+    for ( int split = 0; split <= (int)sizeof(buf); split += 23 )
+    {
+        uint32_t crc1 = tiny_crc32c(PPPINITFCS32C, buf, split);
+        uint32_t crc2 = tiny_crc32c(PPPINITFCS32C, buf + split, sizeof(buf) - split);
+        CHECK_EQUAL(whole, crc32c_combine(crc1, crc2, sizeof(buf) - split));
+    }
+}
+#endif
+
+// Compile time checks of the C++ templates
+static_assert(tinyproto::Fcs16::calc("123456789", 9) == 0x906E, "FCS16 check value");
+static_assert(tinyproto::Fcs32::calc("123456789", 9) == 0xCBF43926, "FCS32 check value");
+static_assert(tinyproto::Crc32c::calc("123456789", 9) == 0xE3069283, "CRC-32C check value");
+static_assert(tinyproto::Crc<uint16_t, 0x1021, 0xFFFF, false, 0>::calc("123456789", 9) == 0x29B1,
+              "CRC-16/CCITT-FALSE check value");
+
+TEST(CRC, cpp_templates_match_c_api)
+{
+    uint8_t buf[300];
+    fill_random(buf, sizeof(buf));
+    for ( int len = 0; len <= (int)sizeof(buf); len += 7 )
+    {
+#ifdef CONFIG_ENABLE_FCS16
+        CHECK_EQUAL(tiny_crc16(PPPINITFCS16, buf, len), tinyproto::Fcs16::compute(buf, len));
+        CHECK_EQUAL(PPPGOODFCS16, tinyproto::Fcs16::residue());
+#endif
+#ifdef CONFIG_ENABLE_FCS32
+        CHECK_EQUAL(tiny_crc32(PPPINITFCS32, buf, len), tinyproto::Fcs32::compute(buf, len));
+        CHECK_EQUAL(PPPGOODFCS32, tinyproto::Fcs32::residue());
+#endif
+#ifdef CONFIG_ENABLE_FCS32C
+        CHECK_EQUAL(tiny_crc32c(PPPINITFCS32C, buf, len), tinyproto::Crc32c::compute(buf, len));
+        CHECK_EQUAL(PPPGOODFCS32C, tinyproto::Crc32c::residue());
+#endif
+    }
+}
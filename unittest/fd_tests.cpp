@@ -26,12 +26,17 @@
     For further information contact via email on github account.
 */
 
+#include <algorithm>
 #include <functional>
 #include <CppUTest/TestHarness.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <unistd.h>
 #include "helpers/tiny_fd_helper.h"
 #include "helpers/fake_connection.h"
 
@@ -151,6 +156,715 @@ TEST(FD, errors_on_tx_line)
     CHECK_EQUAL(200, helper1.rx_count());
 }
 
+TEST(FD, errors_on_tx_line_with_crc_cache)
+{
+    FakeSetup conn(32, 32);
+    TinyHelperFd helper1(&conn.endpoint1(), 2048, TINY_FD_MODE_ABM, nullptr);
+    TinyHelperFd helper2(&conn.endpoint2(), 2048, TINY_FD_MODE_ABM, nullptr);
+    for ( auto helper : {&helper1, &helper2} )
+    {
+        helper->setTimeout(400);
+        helper->setCacheCrc(true);
+        CHECK_EQUAL(TINY_SUCCESS, helper->init());
+    }
+    // Retransmitted frames have new N(R) in the header, but reuse stored payload crc
+    conn.line2().generate_error_every_n_byte(200);
+    helper1.run(true);
+    helper2.run(true);
+
+    for ( int nsent = 0; nsent < 100; nsent++ )
+    {
+        uint8_t txbuf[16];
+        memset(txbuf, nsent, sizeof(txbuf));
+        int result = helper2.send(txbuf, sizeof(txbuf));
+        CHECK_EQUAL(TINY_SUCCESS, result);
+    }
+    helper1.wait_until_rx_count(100, 400);
+    CHECK_EQUAL(100, helper1.rx_count());
+}
+
+TEST(FD, tx_pipeline_encodes_ahead)
+{
+    FakeSetup conn;
+    TinyHelperFd helper1(&conn.endpoint1(), 2048, TINY_FD_MODE_ABM, nullptr);
+    TinyHelperFd helper2(&conn.endpoint2(), 2048, TINY_FD_MODE_ABM, nullptr);
+    // Small blocks make frames span several blocks of the ring
+    helper1.setTxPipeline(2, 64);
+    helper2.setTxPipeline(3, 96);
+    CHECK_EQUAL(TINY_SUCCESS, helper1.init());
+    CHECK_EQUAL(TINY_SUCCESS, helper2.init());
+    helper1.run(true);
+    helper2.run(true);
+
+    for ( int nsent = 0; nsent < 100; nsent++ )
+    {
+        uint8_t txbuf[8] = {0x7E, 0x7D, (uint8_t)nsent, 0x00, 0x11, 0x22, 0x33, 0x44};
+        CHECK_EQUAL(TINY_SUCCESS, helper1.send(txbuf, sizeof(txbuf)));
+        CHECK_EQUAL(TINY_SUCCESS, helper2.send(txbuf, sizeof(txbuf)));
+    }
+    helper1.wait_until_rx_count(100, 500);
+    helper2.wait_until_rx_count(100, 500);
+    CHECK_EQUAL(100, helper1.rx_count());
+    CHECK_EQUAL(100, helper2.rx_count());
+}
+
+TEST(FD, rx_pool_retains_frames)
+{
+    FakeSetup conn;
+    std::mutex lock;
+    std::deque<std::pair<uint8_t *, int>> retained;
+    TinyHelperFd helper1(&conn.endpoint1(), 2048, TINY_FD_MODE_ABM, nullptr);
+    TinyHelperFd helper2(&conn.endpoint2(), 2048, TINY_FD_MODE_ABM, nullptr);
+    helper1.setRxPool(3, 3 * 512, [&](uint8_t *buf, int len) -> bool {
+        std::lock_guard<std::mutex> guard(lock);
+        retained.push_back({buf, len});
+        return true;
+    });
+    CHECK_EQUAL(TINY_SUCCESS, helper1.init());
+    CHECK_EQUAL(TINY_SUCCESS, helper2.init());
+    helper1.run(true);
+    helper2.run(true);
+    std::thread sender([&]() {
+        for ( int nsent = 0; nsent < 50; nsent++ )
+        {
+            uint8_t txbuf[8] = {(uint8_t)nsent, 0x7E, 0x7D, 0x00, (uint8_t)nsent, 0x11, 0x22, (uint8_t)nsent};
+            while ( helper2.send(txbuf, sizeof(txbuf)) == TINY_ERR_TIMEOUT )
+                ;
+        }
+    });
+    // Application holds received frames for a while, decoding of next frames continues meanwhile
+    int processed = 0;
+    for ( int timeout = 2000; processed < 50 && timeout; timeout-- )
+    {
+        std::pair<uint8_t *, int> frame{nullptr, 0};
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if ( retained.size() )
+            {
+                frame = retained.front();
+                retained.pop_front();
+            }
+        }
+        if ( !frame.first )
+        {
+            usleep(1000);
+            continue;
+        }
+        usleep(500);
+        CHECK_EQUAL(8, frame.second);
+        CHECK_EQUAL(processed, frame.first[0]);
+        CHECK_EQUAL(processed, frame.first[7]);
+        CHECK_EQUAL(TINY_ERR_INVALID_DATA, helper1.releaseRx(frame.first + 1));
+        CHECK_EQUAL(TINY_SUCCESS, helper1.releaseRx(frame.first));
+        processed++;
+    }
+    sender.join();
+    CHECK_EQUAL(50, processed);
+}
+
+static int fd_transfer(tiny_fd_handle_t from, tiny_fd_handle_t to)
+{
+    uint8_t stream[1024];
+    int len = tiny_fd_get_tx_data(from, stream, sizeof(stream));
+    if ( len > 0 )
+    {
+        tiny_fd_on_rx_data(to, stream, len);
+    }
+    return len;
+}
+
+TEST(FD, read_batch_single_ack)
+{
+    // Frames are batched, if they are decoded in place, or to rx pool buffers
+    for ( bool use_pool : {false, true} )
+    {
+        std::vector<std::vector<uint8_t>> frames;
+        int batches = 0;
+        std::pair<std::vector<std::vector<uint8_t>> *, int *> batch{&frames, &batches};
+        std::vector<uint8_t> buffer1(4096), buffer2(4096), pool(8 * 512);
+        tiny_fd_handle_t sender = nullptr;
+        tiny_fd_handle_t receiver = nullptr;
+        tiny_fd_init_t init{};
+        init.buffer = buffer1.data();
+        init.buffer_size = (int)buffer1.size();
+        init.window_frames = 7;
+        init.send_timeout = 1000;
+        init.retries = 2;
+        init.crc_type = HDLC_CRC_16;
+        init.on_frame_cb = [](void *, uint8_t *, int) {};
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+        init.buffer = buffer2.data();
+        init.mtu = 0;
+        init.on_frame_cb = nullptr;
+        init.zero_copy_rx = !use_pool;
+        init.rx_pool_buffer = use_pool ? pool.data() : nullptr;
+        init.rx_pool_buffer_size = (int)pool.size();
+        init.rx_pool_frames = 8;
+        init.pdata = &batch;
+        init.on_read_batch_cb = [](void *udata, const tiny_fd_rx_frame_t *frames, int count) {
+            auto batch = static_cast<std::pair<std::vector<std::vector<uint8_t>> *, int *> *>(udata);
+            for ( int i = 0; i < count; i++ )
+            {
+                batch->first->emplace_back(frames[i].data, frames[i].data + frames[i].len);
+            }
+            (*batch->second)++;
+        };
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+        for ( int i = 0; i < 4; i++ )
+        {
+            fd_transfer(sender, receiver);
+            fd_transfer(receiver, sender);
+        }
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+        for ( uint8_t nsent = 0; nsent < 5; nsent++ )
+        {
+            uint8_t txbuf[4] = {nsent, 0x11, 0x22, 0x33};
+            CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+        }
+        // All 5 frames go in single chunk, and are delivered to the application at once
+        fd_transfer(sender, receiver);
+        CHECK_EQUAL(1, batches);
+        CHECK_EQUAL(5, (int)frames.size());
+        for ( uint8_t i = 0; i < 5; i++ )
+        {
+            CHECK_EQUAL(4, (int)frames[i].size());
+            CHECK_EQUAL(i, frames[i][0]);
+        }
+        // And single RR N(R)=5 is sent back
+        uint8_t stream[64];
+        int len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+        CHECK_EQUAL(6, len);
+        CHECK_EQUAL(0x01 | (5 << 5), stream[2] & ~0x10);
+        tiny_fd_close(sender);
+        tiny_fd_close(receiver);
+    }
+}
+
+TEST(FD, reserve_and_commit_packets)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 3;
+    init.send_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    init.buffer = buffer2.data();
+    init.mtu = 0;
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    // Reserved slots occupy the window
+    uint8_t *p1 = static_cast<uint8_t *>(tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 8, 0));
+    uint8_t *p2 = static_cast<uint8_t *>(tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 8, 0));
+    uint8_t *p3 = static_cast<uint8_t *>(tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 8, 0));
+    CHECK(p1 != nullptr && p2 != nullptr && p3 != nullptr);
+    POINTERS_EQUAL(nullptr, tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 8, 0));
+    CHECK_EQUAL(TINY_ERR_INVALID_DATA, tiny_fd_commit_packet(sender, p1 + 1, 4));
+    CHECK_EQUAL(TINY_ERR_INVALID_DATA, tiny_fd_commit_packet(sender, p2, 9));
+
+    // Frames go in commit order, and cancelled reservation frees the slot
+    memcpy(p2, "BBBB", 4);
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_commit_packet(sender, p2, 4));
+    memcpy(p1, "AA", 2);
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_commit_packet(sender, p1, 2));
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_commit_packet(sender, p3, 0));
+    CHECK_EQUAL(TINY_ERR_INVALID_DATA, tiny_fd_commit_packet(sender, p3, 0));
+    fd_transfer(sender, receiver);
+    CHECK_EQUAL(2, (int)frames.size());
+    CHECK(frames[0] == std::vector<uint8_t>({'B', 'B', 'B', 'B'}));
+    CHECK(frames[1] == std::vector<uint8_t>({'A', 'A'}));
+    p3 = static_cast<uint8_t *>(tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 8, 0));
+    CHECK(p3 != nullptr);
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_commit_packet(sender, p3, 0));
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, odd_mtu)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    const int mtu = 33;
+    const int size = tiny_fd_buffer_size_by_mtu_ex(1, mtu, 4, HDLC_CRC_16);
+    std::vector<uint8_t> buffer1(size), buffer2(size);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = size;
+    init.window_frames = 4;
+    init.mtu = mtu;
+    init.send_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.cache_crc = true;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    // Every I-frame slot must stay aligned, even if mtu is odd
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    init.buffer = buffer2.data();
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    CHECK_EQUAL(mtu, tiny_fd_get_mtu(sender));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    for ( int i = 0; i < 12; i++ )
+    {
+        uint8_t txbuf[mtu];
+        memset(txbuf, i, sizeof(txbuf));
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(12, (int)frames.size());
+    for ( int i = 0; i < 12; i++ )
+    {
+        CHECK_EQUAL(mtu, (int)frames[i].size());
+        CHECK_EQUAL(i, frames[i][mtu - 1]);
+    }
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, extended_window)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 20;
+    init.send_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.cache_crc = true;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    // Receiver with small window accepts extended format, requested by the sender.
+    // Batched delivery acknowledges the frames with single RR per batch.
+    init.buffer = buffer2.data();
+    init.window_frames = 3;
+    init.mtu = 0;
+    init.zero_copy_rx = true;
+    init.on_frame_cb = nullptr;
+    init.on_read_batch_cb = [](void *udata, const tiny_fd_rx_frame_t *frames, int count) {
+        for ( int i = 0; i < count; i++ )
+        {
+            static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(frames[i].data,
+                                                                                  frames[i].data + frames[i].len);
+        }
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    // 8 rounds of 20 frames wrap modulo 128 sequence numbers
+    for ( int round = 0; round < 8; round++ )
+    {
+        frames.clear();
+        uint8_t *p = static_cast<uint8_t *>(tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 4, 0));
+        CHECK(p != nullptr);
+        memcpy(p, "RRRR", 4);
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_commit_packet(sender, p, 4));
+        for ( uint8_t nsent = 1; nsent < 20; nsent++ )
+        {
+            uint8_t txbuf[4] = {nsent, (uint8_t)round, 0x22, 0x33};
+            CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+        }
+        // Window is full until the frames are confirmed
+        POINTERS_EQUAL(nullptr, tiny_fd_reserve_packet(sender, TINY_FD_PRIMARY_ADDR, 4, 0));
+        fd_transfer(sender, receiver);
+        CHECK_EQUAL(20, (int)frames.size());
+        CHECK(frames[0] == std::vector<uint8_t>({'R', 'R', 'R', 'R'}));
+        for ( uint8_t i = 1; i < 20; i++ )
+        {
+            CHECK_EQUAL(4, (int)frames[i].size());
+            CHECK_EQUAL(i, frames[i][0]);
+            CHECK_EQUAL(round, frames[i][1]);
+        }
+        // RRs with 7-bit N(R) in the 2nd byte of control field: 7E, ADDR, CTL, CTL, FCS16, 7E
+        uint8_t stream[64];
+        int len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+        CHECK(len > 0 && len % 7 == 0);
+        CHECK_EQUAL(0x01, stream[len - 5]);
+        CHECK_EQUAL(((round + 1) * 20) % 128, stream[len - 4] >> 1);
+        tiny_fd_on_rx_data(sender, stream, len);
+    }
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, selective_reject_resends_missing_frame)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096), pool(4 * 64);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 4;
+    init.mtu = 32;
+    init.send_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    // Receiver holds out-of-order frames in rx pool buffers
+    init.buffer = buffer2.data();
+    init.rx_pool_buffer = pool.data();
+    init.rx_pool_buffer_size = (int)pool.size();
+    init.rx_pool_frames = 4;
+    init.srej = true;
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    uint8_t stream[64];
+    uint8_t txbuf[4] = {0x10, 0x11, 0x12, 0x13};
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    fd_transfer(sender, receiver);
+    fd_transfer(receiver, sender);
+    // Frame N(S)=1 is lost on the line
+    txbuf[0] = 0x20;
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    CHECK(tiny_fd_get_tx_data(sender, stream, sizeof(stream)) > 0);
+    for ( uint8_t i = 3; i < 5; i++ )
+    {
+        txbuf[0] = i << 4;
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    }
+    fd_transfer(sender, receiver);
+    CHECK_EQUAL(1, (int)frames.size());
+    // SREJ with N(R)=1: 7E, ADDR, CTL, FCS16, 7E
+    int len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+    CHECK(len > 0);
+    CHECK_EQUAL(0x2D, stream[2] & ~0x10);
+    tiny_fd_on_rx_data(sender, stream, len);
+    // Only the missing frame is sent again: 7E, ADDR, CTL, DATA, FCS16, 7E
+    len = tiny_fd_get_tx_data(sender, stream, sizeof(stream));
+    CHECK_EQUAL(2, (int)std::count(stream, stream + len, 0x7E));
+    CHECK_EQUAL(0x02, stream[2] & 0x0E);
+    CHECK_EQUAL(0x20, stream[3]);
+    tiny_fd_on_rx_data(receiver, stream, len);
+    CHECK_EQUAL(4, (int)frames.size());
+    for ( uint8_t i = 0; i < 4; i++ )
+    {
+        CHECK_EQUAL((i + 1) << 4, frames[i][0]);
+    }
+    // RR with N(R)=4 confirms held frames too
+    len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+    CHECK(len > 0);
+    CHECK_EQUAL(0x81, stream[len - 4] & ~0x10);
+    tiny_fd_on_rx_data(sender, stream, len);
+    CHECK_EQUAL(0, tiny_fd_get_tx_data(sender, stream, sizeof(stream)));
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, fast_nak_on_crc_error)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 4;
+    init.mtu = 32;
+    init.send_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    init.buffer = buffer2.data();
+    init.fast_nak = true;
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    uint8_t stream[64];
+    uint8_t txbuf[4] = {0x10, 0x11, 0x12, 0x13};
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    fd_transfer(sender, receiver);
+    fd_transfer(receiver, sender);
+    // Payload of I-frame N(S)=1 is corrupted on the line
+    txbuf[0] = 0x20;
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    int len = tiny_fd_get_tx_data(sender, stream, sizeof(stream));
+    CHECK(len > 4);
+    stream[4] ^= 0x01;
+    tiny_fd_on_rx_data(receiver, stream, len);
+    CHECK_EQUAL(1, (int)frames.size());
+    // REJ with N(R)=1 is sent without waiting for retry timeout: 7E, ADDR, CTL, FCS16, 7E
+    len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+    CHECK(len > 0);
+    CHECK_EQUAL(0x25, stream[2] & ~0x10);
+    tiny_fd_on_rx_data(sender, stream, len);
+    fd_transfer(sender, receiver);
+    CHECK_EQUAL(2, (int)frames.size());
+    CHECK_EQUAL(0x20, frames[1][0]);
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, fast_retransmit_on_duplicate_rr)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 4;
+    init.mtu = 32;
+    init.send_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.fast_retransmit = 2;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    init.buffer = buffer2.data();
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    uint8_t stream[64];
+    uint8_t txbuf[4] = {0x10, 0x11, 0x12, 0x13};
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    fd_transfer(sender, receiver);
+    fd_transfer(receiver, sender);
+    // Frame N(S)=1 is lost on the line
+    txbuf[0] = 0x20;
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    CHECK(tiny_fd_get_tx_data(sender, stream, sizeof(stream)) > 0);
+    for ( uint8_t i = 3; i < 6; i++ )
+    {
+        txbuf[0] = i << 4;
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    }
+    fd_transfer(sender, receiver);
+    CHECK_EQUAL(1, (int)frames.size());
+    // REJ with N(R)=1 is lost too: 7E, ADDR, CTL, FCS16, 7E
+    int len = tiny_fd_get_tx_data(receiver, stream, 6);
+    CHECK_EQUAL(6, len);
+    CHECK_EQUAL(0x25, stream[2] & ~0x10);
+    CHECK_EQUAL(0x7E, stream[5]);
+    // Two duplicate RRs with N(R)=1 make the sender to go back to N(S)=1
+    len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+    CHECK_EQUAL(12, len);
+    CHECK_EQUAL(0x21, stream[2] & ~0x10);
+    CHECK_EQUAL(0x21, stream[8] & ~0x10);
+    tiny_fd_on_rx_data(sender, stream, len);
+    fd_transfer(sender, receiver);
+    CHECK_EQUAL(5, (int)frames.size());
+    for ( uint8_t i = 0; i < 5; i++ )
+    {
+        CHECK_EQUAL((i + 1) << 4, frames[i][0]);
+    }
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, checkpoint_resends_missing_frames_only)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 4;
+    init.mtu = 32;
+    init.retry_timeout = 50;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    init.buffer = buffer2.data();
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    uint8_t stream[64];
+    uint8_t txbuf[4] = {0x10, 0x11, 0x12, 0x13};
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    fd_transfer(sender, receiver);
+    // Frames N(S)=1, N(S)=2 and acknowledgement of N(S)=0 are lost on the line
+    for ( uint8_t i = 2; i < 4; i++ )
+    {
+        txbuf[0] = i << 4;
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    }
+    CHECK(tiny_fd_get_tx_data(sender, stream, sizeof(stream)) > 0);
+    uint8_t ack[16];
+    int ack_len = tiny_fd_get_tx_data(receiver, ack, sizeof(ack));
+    CHECK(ack_len > 0);
+    CHECK_EQUAL(1, (int)frames.size());
+    // On retry timeout the sender polls the receiver with RR command: 7E, ADDR | CR, CTL, FCS16, 7E
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    int len = tiny_fd_get_tx_data(sender, stream, 3);
+    CHECK_EQUAL(3, len);
+    CHECK_EQUAL(0x03, stream[1]);
+    CHECK_EQUAL(0x11, stream[2]);
+    // Delayed acknowledgement, sent before the poll went out, is not the answer to the poll
+    tiny_fd_on_rx_data(sender, ack, ack_len);
+    len += tiny_fd_get_tx_data(sender, stream + len, sizeof(stream) - len);
+    CHECK_EQUAL(6, len);
+    tiny_fd_on_rx_data(receiver, stream, len);
+    // Response carries N(R)=1
+    len = tiny_fd_get_tx_data(receiver, stream, sizeof(stream));
+    CHECK(len > 0);
+    CHECK_EQUAL(0x01, stream[1]);
+    CHECK_EQUAL(0x31, stream[2]);
+    tiny_fd_on_rx_data(sender, stream, len);
+    // Frame N(S)=0 is not sent again. Back to back frames may share the flag
+    len = tiny_fd_get_tx_data(sender, stream, sizeof(stream));
+    int count = 0;
+    for ( int i = 0; i + 1 < len; i++ )
+    {
+        count += stream[i] == 0x7E && stream[i + 1] != 0x7E;
+    }
+    CHECK_EQUAL(2, count);
+    CHECK_EQUAL(0x02, stream[2] & 0x0E);
+    tiny_fd_on_rx_data(receiver, stream, len);
+    CHECK_EQUAL(3, (int)frames.size());
+    for ( uint8_t i = 0; i < 3; i++ )
+    {
+        CHECK_EQUAL((i + 1) << 4, frames[i][0]);
+    }
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
+TEST(FD, staged_frames_are_pinned_until_sent)
+{
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> buffer1(4096), buffer2(4096);
+    tiny_fd_handle_t sender = nullptr;
+    tiny_fd_handle_t receiver = nullptr;
+    tiny_fd_init_t init{};
+    init.buffer = buffer1.data();
+    init.buffer_size = (int)buffer1.size();
+    init.window_frames = 4;
+    init.mtu = 32;
+    init.retry_timeout = 1000;
+    init.retries = 2;
+    init.crc_type = HDLC_CRC_16;
+    init.pdata = &frames;
+    init.on_frame_cb = [](void *udata, uint8_t *data, int len) {
+        static_cast<std::vector<std::vector<uint8_t>> *>(udata)->emplace_back(data, data + len);
+    };
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&sender, &init));
+    init.buffer = buffer2.data();
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_init(&receiver, &init));
+    for ( int i = 0; i < 4; i++ )
+    {
+        fd_transfer(sender, receiver);
+        fd_transfer(receiver, sender);
+    }
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_get_status(sender));
+
+    uint8_t stream[128];
+    uint8_t sframe[8];
+    uint8_t txbuf[4] = {0x10, 0x11, 0x12, 0x13};
+    for ( uint8_t i = 1; i < 3; i++ )
+    {
+        txbuf[0] = i << 4;
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    }
+    // Frames N(S)=0 and N(S)=1 are lost on the line, and REJ with N(R)=0 rewinds them
+    CHECK(tiny_fd_get_tx_data(sender, stream, sizeof(stream)) > 0);
+    uint8_t rej[2] = {0x01, 0x15};
+    int len = hdlc_ll_encode_frame(sframe, sizeof(sframe), rej, sizeof(rej), HDLC_CRC_16);
+    tiny_fd_on_rx_data(sender, sframe, len);
+    // Both frames are staged to hdlc level again, but only the start of the first one is sent
+    int sent = tiny_fd_get_tx_data(sender, stream, 4);
+    CHECK_EQUAL(4, sent);
+    // Late RR confirms staged frames, their slots must not be reused until hdlc level sends them
+    uint8_t rr[2] = {0x01, 0x51};
+    len = hdlc_ll_encode_frame(sframe, sizeof(sframe), rr, sizeof(rr), HDLC_CRC_16);
+    tiny_fd_on_rx_data(sender, sframe, len);
+    for ( uint8_t i = 3; i < 5; i++ )
+    {
+        txbuf[0] = i << 4;
+        CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    }
+    txbuf[0] = 0x50;
+    CHECK(tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)) != TINY_SUCCESS);
+    sent += tiny_fd_get_tx_data(sender, stream + sent, sizeof(stream) - sent);
+    CHECK_EQUAL(TINY_SUCCESS, tiny_fd_send_packet(sender, txbuf, sizeof(txbuf)));
+    tiny_fd_on_rx_data(receiver, stream, sent);
+    CHECK_EQUAL(4, (int)frames.size());
+    for ( uint8_t i = 0; i < 4; i++ )
+    {
+        CHECK_EQUAL((i + 1) << 4, frames[i][0]);
+    }
+    tiny_fd_close(sender);
+    tiny_fd_close(receiver);
+}
+
 TEST(FD, error_on_single_I_send)
 {
     // Each U-frame or S-frame is 6 bytes or more: 7F, ADDR, CTL, FSC16, 7F
@@ -257,8 +971,8 @@ TEST(FD, resend_timeout)
     std::this_thread::sleep_for(std::chrono::milliseconds(70 * 2 + 100));
     helper1.stop();
     const uint8_t reconnect_dat[] = {0x7E, 0x01, 0x10, '#',  0x18, 0x1A, 0x7E, // 1-st attempt
-                                     0x7E, 0x01, 0x10, '#',  0x18, 0x1A, 0x7E, // 2-nd attempt (1st retry)
-                                     0x7E, 0x01, 0x10, '#',  0x18, 0x1A, 0x7E, // 3-rd attempt (2nd retry)
+                                     0x7E, 0x03, 0x11, 0x27, 0x24, 0x7E,       // Checkpoint poll (1st retry)
+                                     0x7E, 0x01, 0x10, '#',  0x18, 0x1A, 0x7E, // 2-nd attempt (2nd retry)
                                      0x7E, 0x03, 0x3F, 0x5B, 0xEC, 0x7E};      // Attempt to reconnect (SABM)
     uint8_t buffer[64]{};
     conn.endpoint2().read(buffer, sizeof(buffer));
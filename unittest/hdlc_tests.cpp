@@ -26,7 +26,9 @@
     For further information contact via email on github account.
 */
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 #include <CppUTest/TestHarness.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -112,6 +114,20 @@ TEST(HDLC, crc32)
     CHECK_EQUAL(1, helper2.rx_count());
 }
 
+TEST(HDLC, crc32c)
+{
+    const char *txbuf = "This is CRC32C check";
+    FakeSetup conn;
+    TinyHdlcHelper helper1(&conn.endpoint1(), nullptr, nullptr, 1024, HDLC_CRC_32C);
+    TinyHdlcHelper helper2(
+        &conn.endpoint2(), [&txbuf](uint8_t *buf, int len) -> void { STRCMP_EQUAL(txbuf, (char *)buf); }, nullptr, 1024,
+        HDLC_CRC_32C);
+    int msg_size = strlen(txbuf) + 1;
+    helper1.send((uint8_t *)txbuf, msg_size, 100);
+    helper2.wait_until_rx_count(1, 100);
+    CHECK_EQUAL(1, helper2.rx_count());
+}
+
 TEST(HDLC, send_receive)
 {
     uint32_t bytes_sent = 0;
@@ -281,6 +297,841 @@ TEST(HDLC, hdlc_recv_escape_chars_decode)
     MEMCMP_EQUAL( frame, actual_frame, len);
 }
 
+TEST(HDLC, hdlc_ll_crc_over_split_chunks)
+{
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_8, HDLC_CRC_16, HDLC_CRC_32, HDLC_CRC_32C};
+    const uint8_t frame[] = {0x01, 0x7E, 0x02, 0x7D, 0x7D, 0x03, 0x7E, 0x04, 0x05, 0x06, 0x07};
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        uint8_t buffer[512];
+        std::vector<uint8_t> received;
+        hdlc_ll_handle_t handle;
+        hdlc_ll_init_t init{};
+        init.buf = buffer;
+        init.buf_size = sizeof(buffer);
+        init.crc_type = crc_type;
+        init.user_data = &received;
+        init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+            static_cast<std::vector<uint8_t> *>(user_data)->assign((uint8_t *)data, (uint8_t *)data + len);
+            return 0;
+        };
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame, sizeof(frame)));
+        uint8_t encoded[64];
+        int encoded_len = 0;
+        int result;
+        // Encode by small pieces to check that tx crc survives state switching
+        while ( (result = hdlc_ll_run_tx(handle, encoded + encoded_len, 3)) > 0 )
+        {
+            encoded_len += result;
+        }
+        // Decode byte by byte
+        for ( int i = 0; i < encoded_len; i++ )
+        {
+            hdlc_ll_run_rx(handle, encoded + i, 1, nullptr);
+        }
+        CHECK_EQUAL(sizeof(frame), received.size());
+        MEMCMP_EQUAL(frame, received.data(), sizeof(frame));
+        // Corrupt single payload byte, and check that frame is rejected
+        received.clear();
+        encoded[2] ^= 0x01;
+        int error = TINY_SUCCESS;
+        for ( int i = 0; i < encoded_len; i++ )
+        {
+            hdlc_ll_run_rx(handle, encoded + i, 1, &error);
+            if ( error != TINY_SUCCESS )
+            {
+                break;
+            }
+        }
+        CHECK_EQUAL(TINY_ERR_WRONG_CRC, error);
+        CHECK_EQUAL(0, received.size());
+        hdlc_ll_close(handle);
+    }
+}
+
+static std::vector<uint8_t> hdlc_reference_encode(const uint8_t *data, int len, uint16_t fcs)
+{
+    std::vector<uint8_t> out{0x7E};
+    uint8_t fcs_bytes[2] = {(uint8_t)(fcs & 0xFF), (uint8_t)(fcs >> 8)};
+    for ( int i = 0; i < len + 2; i++ )
+    {
+        uint8_t byte = i < len ? data[i] : fcs_bytes[i - len];
+        if ( byte == 0x7E || byte == 0x7D )
+        {
+            out.push_back(0x7D);
+            byte ^= 0x20;
+        }
+        out.push_back(byte);
+    }
+    out.push_back(0x7E);
+    return out;
+}
+
+TEST(HDLC, hdlc_ll_encode_long_frames_with_special_bytes)
+{
+    uint8_t buffer[512];
+    uint8_t frame[200];
+    uint8_t encoded[512];
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_16;
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    srand(1);
+    for ( int len = 1; len <= (int)sizeof(frame); len++ )
+    {
+        // Special bytes are placed sparsely to cover SIMD blocks with and without them
+        for ( int i = 0; i < len; i++ )
+        {
+            int r = rand() % 64;
+            frame[i] = r == 0 ? 0x7E : (r == 1 ? 0x7D : (uint8_t)rand());
+        }
+        std::vector<uint8_t> expected = hdlc_reference_encode(frame, len, tiny_crc16(PPPINITFCS16, frame, len));
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame, len));
+        int chunk = 1 + len % 40;
+        int encoded_len = 0;
+        int result;
+        while ( (result = hdlc_ll_run_tx(handle, encoded + encoded_len, chunk)) > 0 )
+        {
+            encoded_len += result;
+        }
+        CHECK_EQUAL(expected.size(), (size_t)encoded_len);
+        MEMCMP_EQUAL(expected.data(), encoded, encoded_len);
+    }
+    hdlc_ll_close(handle);
+}
+
+TEST(HDLC, hdlc_ll_decode_long_frames_with_special_bytes)
+{
+    uint8_t buffer[512];
+    uint8_t frame[200];
+    std::vector<uint8_t> received;
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_16;
+    init.user_data = &received;
+    init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+        static_cast<std::vector<uint8_t> *>(user_data)->assign((uint8_t *)data, (uint8_t *)data + len);
+        return 0;
+    };
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    srand(2);
+    for ( int len = 1; len <= (int)sizeof(frame); len++ )
+    {
+        for ( int i = 0; i < len; i++ )
+        {
+            int r = rand() % 64;
+            frame[i] = r == 0 ? 0x7E : (r == 1 ? 0x7D : (uint8_t)rand());
+        }
+        std::vector<uint8_t> encoded = hdlc_reference_encode(frame, len, tiny_crc16(PPPINITFCS16, frame, len));
+        received.clear();
+        int chunk = 1 + len % 40;
+        for ( size_t pos = 0; pos < encoded.size(); pos += chunk )
+        {
+            int size = (int)(encoded.size() - pos) < chunk ? (int)(encoded.size() - pos) : chunk;
+            hdlc_ll_run_rx(handle, encoded.data() + pos, size, nullptr);
+        }
+        CHECK_EQUAL((size_t)len, received.size());
+        MEMCMP_EQUAL(frame, received.data(), len);
+    }
+    hdlc_ll_close(handle);
+}
+
+TEST(HDLC, hdlc_ll_encode_frame_matches_state_machine)
+{
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_OFF, HDLC_CRC_8, HDLC_CRC_16, HDLC_CRC_32, HDLC_CRC_32C};
+    uint8_t frame[100];
+    srand(3);
+    for ( int i = 0; i < (int)sizeof(frame); i++ )
+    {
+        int r = rand() % 16;
+        frame[i] = r == 0 ? 0x7E : (r == 1 ? 0x7D : (uint8_t)rand());
+    }
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        uint8_t buffer[512];
+        hdlc_ll_handle_t handle;
+        hdlc_ll_init_t init{};
+        init.buf = buffer;
+        init.buf_size = sizeof(buffer);
+        init.crc_type = crc_type;
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame, sizeof(frame)));
+        uint8_t expected[HDLC_LL_ENCODED_MAX_SIZE(sizeof(frame), HDLC_CRC_32)];
+        int expected_len = hdlc_ll_run_tx(handle, expected, sizeof(expected));
+        hdlc_ll_close(handle);
+
+        uint8_t encoded[HDLC_LL_ENCODED_MAX_SIZE(sizeof(frame), HDLC_CRC_32)];
+        CHECK_EQUAL(expected_len, hdlc_ll_encode_frame(encoded, sizeof(encoded), frame, sizeof(frame), crc_type));
+        MEMCMP_EQUAL(expected, encoded, expected_len);
+        CHECK_EQUAL(TINY_ERR_DATA_TOO_LARGE,
+                    hdlc_ll_encode_frame(encoded, expected_len - 1, frame, sizeof(frame), crc_type));
+    }
+}
+
+TEST(HDLC, hdlc_ll_decode_buffer)
+{
+    const uint8_t frame1[] = {0x01, 0x7E, 0x02};
+    const uint8_t frame2[] = {0x7D, 0x03, 0x04, 0x05};
+    uint8_t stream[64];
+    int len = 0;
+    stream[len++] = 0xFF; // garbage before the first frame
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame1, sizeof(frame1), HDLC_CRC_16);
+    int bad_frame = len;
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame2, sizeof(frame2), HDLC_CRC_16);
+    len--; // next frame shares the flag with the previous one
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame2, sizeof(frame2), HDLC_CRC_16);
+    int incomplete = len;
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame1, sizeof(frame1), HDLC_CRC_16) - 2;
+    stream[bad_frame + 2] ^= 0x01;
+
+    std::vector<std::vector<uint8_t>> frames;
+    uint8_t buf[16];
+    int result = hdlc_ll_decode_buffer(
+        stream, len, buf, sizeof(buf), HDLC_CRC_16,
+        [](void *user_data, void *data, int len) -> int {
+            static_cast<std::vector<std::vector<uint8_t>> *>(user_data)->emplace_back((uint8_t *)data,
+                                                                                      (uint8_t *)data + len);
+            return 0;
+        },
+        &frames);
+    CHECK_EQUAL(incomplete, result);
+    CHECK_EQUAL(2, frames.size());
+    CHECK_EQUAL(sizeof(frame1), frames[0].size());
+    MEMCMP_EQUAL(frame1, frames[0].data(), sizeof(frame1));
+    CHECK_EQUAL(sizeof(frame2), frames[1].size());
+    MEMCMP_EQUAL(frame2, frames[1].data(), sizeof(frame2));
+}
+
+TEST(HDLC, hdlc_ll_hunt_skips_fill_bytes_and_noise)
+{
+    const uint8_t frame[] = {0x01, 0x02, 0x03};
+    uint8_t stream[160];
+    memset(stream, TINY_HDLC_FILL_BYTE, 100);
+    memcpy(stream + 100, "\x11\x22\x33", 3); // line noise
+    int len = 103 + hdlc_ll_encode_frame(stream + 103, sizeof(stream) - 103, frame, sizeof(frame), HDLC_CRC_16);
+
+    uint8_t buffer[512];
+    int received = 0;
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_16;
+    init.user_data = &received;
+    init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+        *static_cast<int *>(user_data) = len;
+        return 0;
+    };
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    int error;
+    CHECK_EQUAL(len, hdlc_ll_run_rx(handle, stream, len, &error));
+    CHECK_EQUAL(TINY_SUCCESS, error);
+    CHECK_EQUAL((int)sizeof(frame), received);
+#ifdef CONFIG_ENABLE_STATS
+    hdlc_ll_stats_t stats{};
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_get_stats(handle, &stats));
+    CHECK_EQUAL(103, stats.discarded_bytes);
+    CHECK_EQUAL(0, stats.crc_errors);
+#endif
+    hdlc_ll_close(handle);
+}
+
+TEST(HDLC, hdlc_ll_drops_runts_and_fill_between_frames)
+{
+    const uint8_t frame[] = {0x01, 0x02, 0x03};
+    uint8_t stream[160];
+    int len = hdlc_ll_encode_frame(stream, sizeof(stream), frame, sizeof(frame), HDLC_CRC_16);
+    stream[len++] = 0x00; // break condition on UART line, followed by the flag
+    stream[len++] = 0x7E;
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame, sizeof(frame), HDLC_CRC_16);
+    memset(stream + len, TINY_HDLC_FILL_BYTE, 50); // idle line after the closing flag
+    len += 50;
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame, sizeof(frame), HDLC_CRC_16);
+
+    uint8_t buffer[512];
+    int received = 0;
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_16;
+    init.user_data = &received;
+    init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+        (*static_cast<int *>(user_data))++;
+        return 0;
+    };
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    int processed = 0;
+    while ( processed < len )
+    {
+        int error;
+        processed += hdlc_ll_run_rx(handle, stream + processed, len - processed, &error);
+        CHECK_EQUAL(TINY_SUCCESS, error);
+    }
+    CHECK_EQUAL(3, received);
+#ifdef CONFIG_ENABLE_STATS
+    hdlc_ll_stats_t stats{};
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_get_stats(handle, &stats));
+    CHECK_EQUAL(51, stats.discarded_bytes);
+    CHECK_EQUAL(0, stats.crc_errors);
+#endif
+    hdlc_ll_close(handle);
+}
+
+TEST(HDLC, hdlc_ll_frames_starting_with_fill_byte)
+{
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_OFF, HDLC_CRC_8, HDLC_CRC_16, HDLC_CRC_32, HDLC_CRC_32C};
+    // PPP all-stations address, and payload starting with several fill bytes
+    const std::vector<uint8_t> frames[] = {{0xFF, 0x03, 0xC0, 0x21}, {0xFF, 0xFF, 0x11, 0x22, 0x33}};
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        for ( bool shared_flag : {false, true} )
+        {
+            uint8_t stream[64];
+            int len = 0;
+            for ( auto &frame : frames )
+            {
+                // Back to back frames may share the flag
+                int offset = shared_flag && len ? 1 : 0;
+                uint8_t encoded[32];
+                int size = hdlc_ll_encode_frame(encoded, sizeof(encoded), frame.data(), (int)frame.size(), crc_type);
+                memcpy(stream + len, encoded + offset, size - offset);
+                len += size - offset;
+            }
+
+            uint8_t buffer[512];
+            std::vector<std::vector<uint8_t>> received;
+            hdlc_ll_handle_t handle;
+            hdlc_ll_init_t init{};
+            init.buf = buffer;
+            init.buf_size = sizeof(buffer);
+            init.crc_type = crc_type;
+            init.user_data = &received;
+            init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+                static_cast<std::vector<std::vector<uint8_t>> *>(user_data)->emplace_back((uint8_t *)data,
+                                                                                          (uint8_t *)data + len);
+                return 0;
+            };
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+            for ( int processed = 0; processed < len; )
+            {
+                int error;
+                processed += hdlc_ll_run_rx(handle, stream + processed, len - processed, &error);
+                CHECK_EQUAL(TINY_SUCCESS, error);
+            }
+            CHECK_EQUAL(2, (int)received.size());
+            CHECK(frames[0] == received[0]);
+            CHECK(frames[1] == received[1]);
+            hdlc_ll_close(handle);
+        }
+    }
+}
+
+TEST(HDLC, hdlc_ll_tx_queue_shares_flags)
+{
+    const int frames_count = CONFIG_HDLC_LL_TX_QUEUE_SIZE + 1;
+    uint8_t frames[frames_count][20];
+    std::vector<uint8_t> expected;
+    for ( int i = 0; i < frames_count; i++ )
+    {
+        for ( int j = 0; j < (int)sizeof(frames[i]); j++ )
+        {
+            frames[i][j] = (uint8_t)(i * 32 + j * 7);
+        }
+        uint8_t encoded[HDLC_LL_ENCODED_MAX_SIZE(sizeof(frames[i]), HDLC_CRC_16)];
+        int encoded_len = hdlc_ll_encode_frame(encoded, sizeof(encoded), frames[i], sizeof(frames[i]), HDLC_CRC_16);
+        // Back to back frames share single flag
+        expected.insert(expected.end(), encoded + (i ? 1 : 0), encoded + encoded_len);
+    }
+
+    uint8_t buffer[512];
+    std::vector<std::vector<uint8_t>> received;
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_16;
+    init.user_data = &received;
+    init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+        static_cast<std::vector<std::vector<uint8_t>> *>(user_data)->emplace_back((uint8_t *)data,
+                                                                                  (uint8_t *)data + len);
+        return 0;
+    };
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    for ( int i = 0; i < frames_count; i++ )
+    {
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frames[i], sizeof(frames[i])));
+    }
+    CHECK_EQUAL(TINY_ERR_BUSY, hdlc_ll_put(handle, frames[0], sizeof(frames[0])));
+    uint8_t stream[512];
+    int len = hdlc_ll_run_tx(handle, stream, sizeof(stream));
+    CHECK_EQUAL((int)expected.size(), len);
+    MEMCMP_EQUAL(expected.data(), stream, len);
+
+    // The same handle decodes own stream, closing flag is used as opening one
+    const uint8_t *ptr = stream;
+    while ( len > 0 )
+    {
+        int processed = hdlc_ll_run_rx(handle, ptr, len, nullptr);
+        ptr += processed;
+        len -= processed;
+    }
+    CHECK_EQUAL(frames_count, (int)received.size());
+    for ( int i = 0; i < frames_count; i++ )
+    {
+        CHECK_EQUAL(sizeof(frames[i]), received[i].size());
+        MEMCMP_EQUAL(frames[i], received[i].data(), sizeof(frames[i]));
+    }
+    hdlc_ll_close(handle);
+}
+
+static std::vector<uint8_t> cobs_encode(const std::vector<uint8_t> &frame, hdlc_crc_t crc_type, int chunk)
+{
+    uint8_t buffer[512];
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = crc_type;
+    init.framing = HDLC_FRAMING_COBS;
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame.data(), (int)frame.size()));
+    std::vector<uint8_t> stream;
+    uint8_t out[16];
+    int len;
+    while ( (len = hdlc_ll_run_tx(handle, out, chunk)) > 0 )
+    {
+        stream.insert(stream.end(), out, out + len);
+    }
+    hdlc_ll_close(handle);
+    return stream;
+}
+
+TEST(HDLC, cobs_encode_reference_vectors)
+{
+    std::vector<uint8_t> block(254, 0x01);
+    std::vector<uint8_t> expected{0x00, 0xFF};
+    expected.insert(expected.end(), block.begin(), block.end());
+    expected.push_back(0x00);
+
+    CHECK(cobs_encode({0x11, 0x22, 0x00, 0x33}, HDLC_CRC_OFF, 16) ==
+          (std::vector<uint8_t>{0x00, 0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    CHECK(cobs_encode({0x00}, HDLC_CRC_OFF, 16) == (std::vector<uint8_t>{0x00, 0x01, 0x01, 0x00}));
+    CHECK(cobs_encode({0x11, 0x00, 0x00}, HDLC_CRC_OFF, 16) ==
+          (std::vector<uint8_t>{0x00, 0x02, 0x11, 0x01, 0x01, 0x00}));
+    // 254 non-zero bytes fit single block without trailing zero
+    CHECK(cobs_encode(block, HDLC_CRC_OFF, 16) == expected);
+    block.push_back(0x01);
+    expected.insert(expected.end() - 1, {0x02, 0x01});
+    CHECK(cobs_encode(block, HDLC_CRC_OFF, 1) == expected);
+}
+
+TEST(HDLC, cobs_roundtrip_with_zero_bytes)
+{
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_OFF, HDLC_CRC_8, HDLC_CRC_16, HDLC_CRC_32, HDLC_CRC_32C};
+    const int sizes[] = {1, 253, 254, 255, 600};
+    srand(11);
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        for ( int size : sizes )
+        {
+            std::vector<uint8_t> frame(size);
+            for ( auto &byte : frame )
+            {
+                byte = rand() % 8 ? (uint8_t)rand() : 0x00;
+            }
+            std::vector<uint8_t> stream = cobs_encode(frame, crc_type, 7);
+            int crc_size = crc_type == HDLC_CRC_OFF ? 0 : (int)crc_type / 8;
+            // Bounded overhead: 2 delimiters and 1 code byte per every started 254 bytes
+            CHECK(stream.size() <= (size_t)(size + crc_size + 2 + (size + crc_size) / 254 + 1));
+            CHECK(std::find(stream.begin() + 1, stream.end() - 1, 0x00) == stream.end() - 1);
+
+            uint8_t buffer[1024];
+            std::vector<uint8_t> received;
+            hdlc_ll_handle_t handle;
+            hdlc_ll_init_t init{};
+            init.buf = buffer;
+            init.buf_size = sizeof(buffer);
+            init.crc_type = crc_type;
+            init.framing = HDLC_FRAMING_COBS;
+            init.user_data = &received;
+            init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+                static_cast<std::vector<uint8_t> *>(user_data)->assign((uint8_t *)data, (uint8_t *)data + len);
+                return 0;
+            };
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+            for ( size_t pos = 0; pos < stream.size(); )
+            {
+                int error;
+                int chunk = stream.size() - pos < 5 ? (int)(stream.size() - pos) : 5;
+                pos += hdlc_ll_run_rx(handle, stream.data() + pos, chunk, &error);
+                CHECK_EQUAL(TINY_SUCCESS, error);
+            }
+            CHECK(frame == received);
+            hdlc_ll_close(handle);
+        }
+    }
+}
+
+TEST(HDLC, cobs_roundtrip_with_long_first_run)
+{
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_OFF, HDLC_CRC_8, HDLC_CRC_16, HDLC_CRC_32, HDLC_CRC_32C};
+    // First block of the frame has 254 non-zero bytes, so the frame starts with 0xFF code byte
+    std::vector<uint8_t> frame(300);
+    for ( size_t i = 0; i < frame.size(); i++ )
+    {
+        frame[i] = (uint8_t)(i % 255 + 1);
+    }
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        std::vector<uint8_t> stream = cobs_encode(frame, crc_type, 16);
+        CHECK_EQUAL(0xFF, stream[1]);
+        // Second frame shares the delimiter with the first one
+        std::vector<uint8_t> second = cobs_encode(frame, crc_type, 16);
+        stream.insert(stream.end(), second.begin() + 1, second.end());
+
+        uint8_t buffer[1024];
+        std::vector<std::vector<uint8_t>> received;
+        hdlc_ll_handle_t handle;
+        hdlc_ll_init_t init{};
+        init.buf = buffer;
+        init.buf_size = sizeof(buffer);
+        init.crc_type = crc_type;
+        init.framing = HDLC_FRAMING_COBS;
+        init.user_data = &received;
+        init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+            static_cast<std::vector<std::vector<uint8_t>> *>(user_data)->emplace_back((uint8_t *)data,
+                                                                                      (uint8_t *)data + len);
+            return 0;
+        };
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+        for ( size_t pos = 0; pos < stream.size(); )
+        {
+            int error;
+            pos += hdlc_ll_run_rx(handle, stream.data() + pos, (int)(stream.size() - pos), &error);
+            CHECK_EQUAL(TINY_SUCCESS, error);
+        }
+        CHECK_EQUAL(2, (int)received.size());
+        CHECK(frame == received[0]);
+        CHECK(frame == received[1]);
+        hdlc_ll_close(handle);
+    }
+}
+
+TEST(HDLC, length_framing_roundtrip)
+{
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_OFF, HDLC_CRC_16, HDLC_CRC_32};
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        std::vector<std::vector<uint8_t>> received;
+        uint8_t buffer[1024];
+        hdlc_ll_handle_t handle;
+        hdlc_ll_init_t init{};
+        init.buf = buffer;
+        init.buf_size = sizeof(buffer);
+        init.crc_type = crc_type;
+        init.framing = HDLC_FRAMING_LENGTH;
+        init.user_data = &received;
+        init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+            static_cast<std::vector<std::vector<uint8_t>> *>(user_data)->emplace_back((uint8_t *)data,
+                                                                                    (uint8_t *)data + len);
+            return 0;
+        };
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+        const uint8_t frame1[] = {0x7E, 0x7D, 0x00, 0x01};
+        uint8_t frame2[300];
+        for ( size_t i = 0; i < sizeof(frame2); i++ )
+        {
+            frame2[i] = (uint8_t)i;
+        }
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame1, sizeof(frame1)));
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame2, sizeof(frame2)));
+        std::vector<uint8_t> stream;
+        uint8_t chunk[7];
+        int len;
+        while ( (len = hdlc_ll_run_tx(handle, chunk, sizeof(chunk))) > 0 )
+        {
+            stream.insert(stream.end(), chunk, chunk + len);
+        }
+        // Frames are sent as is, prefixed with length of data and crc field
+        int crc_size = crc_type == HDLC_CRC_OFF ? 0 : (int)crc_type / 8;
+        CHECK_EQUAL(2 + sizeof(frame1) + 2 + sizeof(frame2) + 2 * crc_size, stream.size());
+        CHECK_EQUAL(sizeof(frame1) + crc_size, stream[0] | (stream[1] << 8));
+        MEMCMP_EQUAL(frame1, &stream[2], sizeof(frame1));
+        // Zero length frames between the frames are skipped
+        stream.insert(stream.begin() + 2 + sizeof(frame1) + crc_size, 2, 0x00);
+        for ( size_t pos = 0; pos < stream.size(); )
+        {
+            int error;
+            int n = stream.size() - pos < 5 ? (int)(stream.size() - pos) : 5;
+            pos += hdlc_ll_run_rx(handle, stream.data() + pos, n, &error);
+            CHECK_EQUAL(TINY_SUCCESS, error);
+        }
+        CHECK_EQUAL(2, received.size());
+        CHECK(std::vector<uint8_t>(frame1, frame1 + sizeof(frame1)) == received[0]);
+        CHECK(std::vector<uint8_t>(frame2, frame2 + sizeof(frame2)) == received[1]);
+        hdlc_ll_close(handle);
+    }
+}
+
+TEST(HDLC, length_framing_drops_too_long_frame)
+{
+    int frames = 0;
+    uint8_t buffer[512];
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_OFF;
+    init.framing = HDLC_FRAMING_LENGTH;
+    init.user_data = &frames;
+    init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+        (*static_cast<int *>(user_data))++;
+        return 0;
+    };
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    std::vector<uint8_t> stream = {0xE8, 0x03}; // 1000 bytes
+    stream.resize(stream.size() + 1000, 0x55);
+    stream.insert(stream.end(), {0x02, 0x00, 0x11, 0x22});
+    int error;
+    int pos = hdlc_ll_run_rx(handle, stream.data(), (int)stream.size(), &error);
+    CHECK_EQUAL(TINY_ERR_WRONG_CRC, error);
+    hdlc_ll_run_rx(handle, stream.data() + pos, (int)stream.size() - pos, &error);
+    CHECK_EQUAL(TINY_SUCCESS, error);
+    CHECK_EQUAL(1, frames);
+    hdlc_ll_close(handle);
+}
+
+static std::vector<uint8_t> hdlc_ll_send_all(hdlc_ll_handle_t handle)
+{
+    std::vector<uint8_t> stream;
+    uint8_t chunk[5];
+    int len;
+    while ( (len = hdlc_ll_run_tx(handle, chunk, sizeof(chunk))) > 0 )
+    {
+        stream.insert(stream.end(), chunk, chunk + len);
+    }
+    return stream;
+}
+
+TEST(HDLC, put_iov_matches_contiguous_frame)
+{
+    const hdlc_framing_t framings[] = {HDLC_FRAMING_HDLC, HDLC_FRAMING_COBS, HDLC_FRAMING_LENGTH};
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_OFF, HDLC_CRC_8, HDLC_CRC_32};
+    uint8_t frame[600];
+    srand(13);
+    for ( auto &byte : frame )
+    {
+        byte = rand() % 4 ? (uint8_t)rand() : (rand() % 2 ? 0x00 : 0x7E);
+    }
+    // Empty and single byte segments, and COBS block crossing segments boundaries
+    const hdlc_ll_iov_t segs[] = {
+        {nullptr, 0}, {frame, 2}, {frame + 2, 1}, {nullptr, 0}, {frame + 3, 200}, {frame + 203, 250}, {frame + 453, 147},
+    };
+    for ( hdlc_framing_t framing : framings )
+    {
+        for ( hdlc_crc_t crc_type : crc_types )
+        {
+            uint8_t buffer[1024];
+            int sent_len = 0;
+            hdlc_ll_handle_t handle;
+            hdlc_ll_init_t init{};
+            init.buf = buffer;
+            init.buf_size = sizeof(buffer);
+            init.crc_type = crc_type;
+            init.framing = framing;
+            init.user_data = &sent_len;
+            init.on_frame_sent = [](void *user_data, const void *data, int len) -> int {
+                *static_cast<int *>(user_data) += len;
+                return 0;
+            };
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame, sizeof(frame)));
+            std::vector<uint8_t> expected = hdlc_ll_send_all(handle);
+            hdlc_ll_reset(handle, HDLC_LL_RESET_BOTH);
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put_iov(handle, segs, sizeof(segs) / sizeof(segs[0])));
+            CHECK(expected == hdlc_ll_send_all(handle));
+            CHECK_EQUAL(2 * (int)sizeof(frame), sent_len);
+            hdlc_ll_close(handle);
+        }
+    }
+}
+
+TEST(HDLC, put_iov_rejects_empty_frame)
+{
+    uint8_t buffer[512];
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    const hdlc_ll_iov_t segs[] = {{nullptr, 0}, {buffer, 0}};
+    CHECK_EQUAL(TINY_ERR_INVALID_DATA, hdlc_ll_put_iov(handle, segs, 2));
+    CHECK_EQUAL(TINY_ERR_INVALID_DATA, hdlc_ll_put_iov(handle, segs, 0));
+    hdlc_ll_close(handle);
+}
+
+TEST(HDLC, zero_copy_rx_delivers_frames_in_place)
+{
+    struct Received
+    {
+        std::vector<std::vector<uint8_t>> frames;
+        std::vector<const uint8_t *> pointers;
+    } received;
+    uint8_t buffer[512];
+    hdlc_ll_handle_t handle;
+    hdlc_ll_init_t init{};
+    init.buf = buffer;
+    init.buf_size = sizeof(buffer);
+    init.crc_type = HDLC_CRC_16;
+    init.zero_copy_rx = true;
+    init.user_data = &received;
+    init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+        Received *r = static_cast<Received *>(user_data);
+        r->frames.emplace_back((uint8_t *)data, (uint8_t *)data + len);
+        r->pointers.push_back((const uint8_t *)data);
+        return 0;
+    };
+    CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+    const uint8_t frame1[] = {0x01, 0x02, 0x03};
+    const uint8_t frame2[] = {0x04, 0x7E, 0x05};
+    const uint8_t frame3[] = {0x06, 0x07, 0x08, 0x09};
+    uint8_t stream[64];
+    int len = 0;
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame1, sizeof(frame1), HDLC_CRC_16);
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame2, sizeof(frame2), HDLC_CRC_16);
+    int frame3_pos = len;
+    len += hdlc_ll_encode_frame(stream + len, sizeof(stream) - len, frame3, sizeof(frame3), HDLC_CRC_16);
+    for ( int pos = 0; pos < len; )
+    {
+        int error;
+        pos += hdlc_ll_run_rx(handle, stream + pos, len - pos, &error);
+        CHECK_EQUAL(TINY_SUCCESS, error);
+    }
+    CHECK_EQUAL(3, received.frames.size());
+    CHECK(std::vector<uint8_t>(frame1, frame1 + sizeof(frame1)) == received.frames[0]);
+    CHECK(std::vector<uint8_t>(frame2, frame2 + sizeof(frame2)) == received.frames[1]);
+    CHECK(std::vector<uint8_t>(frame3, frame3 + sizeof(frame3)) == received.frames[2]);
+    // Frames without escapes are not copied, escaped one goes through rx buffer
+    POINTERS_EQUAL(stream + 1, received.pointers[0]);
+    CHECK(received.pointers[1] > buffer && received.pointers[1] < buffer + sizeof(buffer));
+    POINTERS_EQUAL(stream + frame3_pos + 1, received.pointers[2]);
+    // Frame split between two chunks falls back to the copy path
+    received.frames.clear();
+    int error;
+    int pos = hdlc_ll_run_rx(handle, stream + frame3_pos, 4, &error);
+    while ( pos < len - frame3_pos )
+    {
+        pos += hdlc_ll_run_rx(handle, stream + frame3_pos + pos, len - frame3_pos - pos, &error);
+    }
+    CHECK_EQUAL(1, received.frames.size());
+    CHECK(std::vector<uint8_t>(frame3, frame3 + sizeof(frame3)) == received.frames[0]);
+    // Corrupted frame is rejected in place too
+    stream[frame3_pos + 2] ^= 0x01;
+    hdlc_ll_run_rx(handle, stream + frame3_pos, len - frame3_pos, &error);
+    CHECK_EQUAL(TINY_ERR_WRONG_CRC, error);
+    CHECK_EQUAL(1, received.frames.size());
+    hdlc_ll_close(handle);
+}
+
+TEST(HDLC, table_decoder_matches_default_decoder)
+{
+    struct Received
+    {
+        std::vector<std::vector<uint8_t>> frames;
+        std::vector<int> errors;
+    };
+    // Frames with escapes, noise between frames, corrupted and too long frames
+    std::vector<uint8_t> stream;
+    srand(17);
+    for ( int i = 0; i < 200; i++ )
+    {
+        std::vector<uint8_t> frame(1 + rand() % (i % 10 ? 64 : 300));
+        for ( auto &byte : frame )
+        {
+            byte = rand() % 3 ? (uint8_t)rand() : (rand() % 2 ? 0x7E : 0x7D);
+        }
+        uint8_t encoded[1024];
+        int len = hdlc_ll_encode_frame(encoded, sizeof(encoded), frame.data(), (int)frame.size(), HDLC_CRC_16);
+        if ( i % 7 == 0 )
+        {
+            encoded[1 + rand() % (len - 2)] ^= 0x01;
+        }
+        stream.insert(stream.end(), encoded, encoded + len);
+        for ( int n = i % 5 ? 0 : rand() % 20; n > 0; n-- )
+        {
+            stream.push_back(rand() % 4 ? 0xFF : (uint8_t)rand());
+        }
+    }
+    Received results[2];
+    for ( int table = 0; table < 2; table++ )
+    {
+        uint8_t buffer[512];
+        hdlc_ll_handle_t handle;
+        hdlc_ll_init_t init{};
+        init.buf = buffer;
+        init.buf_size = sizeof(buffer);
+        init.crc_type = HDLC_CRC_16;
+        init.table_decoder = table;
+        init.user_data = &results[table];
+        init.on_frame_read = [](void *user_data, void *data, int len) -> int {
+            static_cast<Received *>(user_data)->frames.emplace_back((uint8_t *)data, (uint8_t *)data + len);
+            return 0;
+        };
+        CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+        for ( size_t pos = 0; pos < stream.size(); )
+        {
+            int error;
+            int chunk = stream.size() - pos < 13 ? (int)(stream.size() - pos) : 13;
+            pos += hdlc_ll_run_rx(handle, stream.data() + pos, chunk, &error);
+            results[table].errors.push_back(error);
+        }
+        hdlc_ll_close(handle);
+    }
+    CHECK(results[0].frames.size() > 100);
+    CHECK(results[0].frames == results[1].frames);
+    CHECK(results[0].errors == results[1].errors);
+}
+
+TEST(HDLC, put_with_crc_matches_calculated_crc)
+{
+    const hdlc_framing_t framings[] = {HDLC_FRAMING_HDLC, HDLC_FRAMING_COBS, HDLC_FRAMING_LENGTH};
+    const hdlc_crc_t crc_types[] = {HDLC_CRC_8, HDLC_CRC_16, HDLC_CRC_32, HDLC_CRC_32C};
+    uint8_t frame[100];
+    for ( size_t i = 0; i < sizeof(frame); i++ )
+    {
+        frame[i] = (uint8_t)(i * 7 + 0x70);
+    }
+    for ( hdlc_crc_t crc_type : crc_types )
+    {
+        // Header and payload crc are combined without reading the data
+        uint32_t crc = hdlc_ll_crc_combine(crc_type, hdlc_ll_crc(crc_type, frame, 2),
+                                           hdlc_ll_crc(crc_type, frame + 2, sizeof(frame) - 2), sizeof(frame) - 2);
+        CHECK_EQUAL(hdlc_ll_crc(crc_type, frame, sizeof(frame)), crc);
+        for ( hdlc_framing_t framing : framings )
+        {
+            uint8_t buffer[512];
+            hdlc_ll_handle_t handle;
+            hdlc_ll_init_t init{};
+            init.buf = buffer;
+            init.buf_size = sizeof(buffer);
+            init.crc_type = crc_type;
+            init.framing = framing;
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_init(&handle, &init));
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put(handle, frame, sizeof(frame)));
+            std::vector<uint8_t> expected = hdlc_ll_send_all(handle);
+            hdlc_ll_reset(handle, HDLC_LL_RESET_BOTH);
+            CHECK_EQUAL(TINY_SUCCESS, hdlc_ll_put_with_crc(handle, frame, sizeof(frame), crc));
+            CHECK(expected == hdlc_ll_send_all(handle));
+            hdlc_ll_close(handle);
+        }
+    }
+}
 
 TEST(HDLC, hdlc_incomplete_send_on_close)
 {
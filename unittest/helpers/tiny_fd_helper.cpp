@@ -56,6 +56,29 @@ void TinyHelperFd::setTimeout(int timeout)
     m_timeout = timeout;
 }
 
+void TinyHelperFd::setCacheCrc(bool enable)
+{
+    m_cacheCrc = enable;
+}
+
+void TinyHelperFd::setTxPipeline(uint8_t blocks, int size)
+{
+    m_txPipeBlocks = blocks;
+    m_txPipe.resize(size);
+}
+
+void TinyHelperFd::setRxPool(uint8_t frames, int size, const std::function<bool(uint8_t *, int)> &onRetainCb)
+{
+    m_rxPoolFrames = frames;
+    m_rxPool.resize(size);
+    m_onRetainCb = onRetainCb;
+}
+
+int TinyHelperFd::releaseRx(uint8_t *buf)
+{
+    return tiny_fd_release_rx(m_handle, buf);
+}
+
 void TinyHelperFd::setAddress(uint8_t address)
 {
     m_addr = address;
@@ -83,8 +106,40 @@ int TinyHelperFd::init()
     init.peers_count = m_peersCount;
     init.addr = m_addr;
     init.crc_type = HDLC_CRC_16;
+    init.cache_crc = m_cacheCrc;
+    if ( m_txPipeBlocks )
+    {
+        init.tx_pipe_buffer = m_txPipe.data();
+        init.tx_pipe_buffer_size = (int)m_txPipe.size();
+        init.tx_pipe_blocks = m_txPipeBlocks;
+    }
+    if ( m_rxPoolFrames )
+    {
+        init.on_frame_cb = nullptr;
+        init.on_rx_frame_cb = onRxRetain;
+        init.rx_pool_buffer = m_rxPool.data();
+        init.rx_pool_buffer_size = (int)m_rxPool.size();
+        init.rx_pool_frames = m_rxPoolFrames;
+    }
+
+    int result = tiny_fd_init(&m_handle, &init);
+    if ( result == TINY_SUCCESS && m_txPipeBlocks )
+    {
+        m_stop_encoder = false;
+        m_encoder = new std::thread(Encoder, this);
+    }
+    return result;
+}
 
-    return tiny_fd_init(&m_handle, &init);
+void TinyHelperFd::Encoder(TinyHelperFd *helper)
+{
+    while ( !helper->m_stop_encoder )
+    {
+        if ( tiny_fd_tx_encode(helper->m_handle, 10) == 0 )
+        {
+            usleep(100);
+        }
+    }
 }
 
 void TinyHelperFd::set_connect_cb(const std::function<void(uint8_t, bool)> &onConnectCb)
@@ -139,6 +194,26 @@ int TinyHelperFd::send(int count, const std::string &msg)
 
 int TinyHelperFd::run_tx()
 {
+    if ( m_txPipeBlocks )
+    {
+        const void *data;
+        int len = tiny_fd_tx_acquire(m_handle, &data, 10);
+        const uint8_t *ptr = static_cast<const uint8_t *>(data);
+        while ( len > 0 )
+        {
+            int i = write_data(this, ptr, len);
+            if ( i > 0 )
+            {
+                len -= i;
+                ptr += i;
+            }
+        }
+        if ( len == 0 )
+        {
+            tiny_fd_tx_release(m_handle);
+        }
+        return 0;
+    }
     uint8_t buf[16];
     int len = tiny_fd_get_tx_data(m_handle, buf, sizeof(buf));
     uint8_t *ptr = buf;
@@ -177,6 +252,14 @@ void TinyHelperFd::onRxFrame(void *handle, uint8_t *buf, int len)
     }
 }
 
+int TinyHelperFd::onRxRetain(void *handle, uint8_t addr, uint8_t *buf, int len)
+{
+    TinyHelperFd *helper = reinterpret_cast<TinyHelperFd *>(handle);
+    bool retain = helper->m_onRetainCb && helper->m_onRetainCb(buf, len);
+    helper->m_rx_count++;
+    return retain ? TINY_FD_RX_RETAIN : 0;
+}
+
 void TinyHelperFd::onTxFrame(void *handle, uint8_t *buf, int len)
 {
     TinyHelperFd *helper = reinterpret_cast<TinyHelperFd *>(handle);
@@ -197,5 +280,12 @@ TinyHelperFd::~TinyHelperFd()
     // stop sender thread
     send(0, "");
     stop();
+    if ( m_encoder )
+    {
+        m_stop_encoder = true;
+        m_encoder->join();
+        delete m_encoder;
+        m_encoder = nullptr;
+    }
     tiny_fd_close(m_handle);
 }
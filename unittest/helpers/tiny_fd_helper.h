@@ -33,6 +33,7 @@
 #include <stdint.h>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include "proto/fd/tiny_fd.h"
 #include "fake_endpoint.h"
 
@@ -52,6 +53,12 @@ public:
     void setAddress(uint8_t address);
     void setPeersCount(uint8_t count);
     void setTimeout(int timeout);
+    void setCacheCrc(bool enable);
+    // Enables encode-ahead tx pipeline with separate encoder thread
+    void setTxPipeline(uint8_t blocks, int size);
+    // Enables rx frames pool, frames are retained if callback returns true
+    void setRxPool(uint8_t frames, int size, const std::function<bool(uint8_t *, int)> &onRetainCb);
+    int releaseRx(uint8_t *buf);
     int init();
 
     int registerPeer(uint8_t address);
@@ -94,9 +101,19 @@ private:
     int m_rxBufferSize;
     int m_window;
     int m_timeout;
+    bool m_cacheCrc = false;
+    std::vector<uint8_t> m_txPipe;
+    uint8_t m_txPipeBlocks = 0;
+    std::thread *m_encoder = nullptr;
+    std::atomic<bool> m_stop_encoder{false};
+    std::vector<uint8_t> m_rxPool;
+    uint8_t m_rxPoolFrames = 0;
+    std::function<bool(uint8_t *, int)> m_onRetainCb;
 
     static void onRxFrame(void *handle, uint8_t *buf, int len);
+    static int onRxRetain(void *handle, uint8_t addr, uint8_t *buf, int len);
     static void onTxFrame(void *handle, uint8_t *buf, int len);
     static void onConnect(void *handle, uint8_t addr, bool connected);
     static void MessageSender(TinyHelperFd *helper, int count, std::string message);
+    static void Encoder(TinyHelperFd *helper);
 };